@@ -0,0 +1,153 @@
+#include "Algorithms.h"
+#include "Benchmark.h"
+#include "Vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+struct Buffers {
+    Vector<uint64_t> original;
+    Vector<uint64_t> data;
+    Vector<uint64_t> out;
+};
+
+struct Algorithm {
+    const char* name;
+    // Sort and partition reorder their input, which is restored from `original` before every run
+    bool reorders_input;
+    void (*serial)(Buffers&);
+    void (*parallel)(Buffers&);
+};
+
+// The std algorithms get plain pointers, Vector's iterators are not standard library iterators
+inline uint64_t* begin(Vector<uint64_t>& vector) { return vector.data(); }
+inline uint64_t* end(Vector<uint64_t>& vector) { return vector.data() + vector.size(); }
+
+// A lambda rather than a function, which would reach the parallel loop as a pointer called for every element
+constexpr auto mix = [](uint64_t value) { return (value * 0x9E3779B97F4A7C15ull) >> 7; };
+
+const Algorithm algorithms[] = {
+    { "for_each", false,
+        [](Buffers& b) { std::for_each(begin(b.data), end(b.data), [](uint64_t& value) { value = value * 3 + 1; }); },
+        [](Buffers& b) { parallel_for_each(b.data.begin(), b.data.end(), [](uint64_t& value) { value = value * 3 + 1; }); } },
+    { "transform", false,
+        [](Buffers& b) { std::transform(begin(b.data), end(b.data), begin(b.out), mix); },
+        [](Buffers& b) { parallel_transform(b.data.begin(), b.data.end(), b.out.begin(), mix); } },
+    { "reduce", false,
+        [](Buffers& b) { Benchmark::do_not_optimize(std::accumulate(begin(b.data), end(b.data), uint64_t(0))); },
+        [](Buffers& b) { Benchmark::do_not_optimize(parallel_reduce(b.data.begin(), b.data.end(), uint64_t(0))); } },
+    { "inclusive_scan", false,
+        [](Buffers& b) { std::inclusive_scan(begin(b.data), end(b.data), begin(b.out)); },
+        [](Buffers& b) { parallel_inclusive_scan(b.data.begin(), b.data.end(), b.out.begin()); } },
+    { "sort", true,
+        [](Buffers& b) { std::sort(begin(b.data), end(b.data)); },
+        [](Buffers& b) { parallel_sort(b.data.begin(), b.data.end()); } },
+    { "partition", true,
+        [](Buffers& b) { std::stable_partition(begin(b.data), end(b.data), [](uint64_t value) { return value & 1; }); },
+        [](Buffers& b) { parallel_partition(b.data.begin(), b.data.end(), [](uint64_t value) { return value & 1; }); } },
+};
+
+constexpr size_t algorithm_count = sizeof(algorithms) / sizeof(algorithms[0]);
+constexpr size_t max_sizes = 8;
+
+void fill(Buffers& buffers, size_t count)
+{
+    std::mt19937_64 random(count);
+    buffers.original.clear();
+    buffers.original.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        buffers.original.push_back(random());
+    buffers.data = buffers.original;
+    buffers.out.resize(count);
+}
+
+double measure(const Algorithm& algorithm, Buffers& buffers, void (*run)(Buffers&))
+{
+    auto restore = [&] {
+        if (algorithm.reorders_input)
+            buffers.data = buffers.original;
+    };
+    // Warms the pool and the allocator up, the first run also creates the pool
+    restore();
+    run(buffers);
+    return Benchmark::fastest_run_with_setup(restore, [&] { run(buffers); });
+}
+
+void print_sizes_header(const char* first_column)
+{
+    std::printf("%8s %12s", first_column, "elements");
+    for (const Algorithm& algorithm : algorithms)
+        std::printf(" %14s", algorithm.name);
+    std::printf("\n");
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    // 10^9 elements need about 32 GB for sort, the default stays within a few GB
+    size_t max_elements = Benchmark::size_option(argc, argv, "max-elements", quick ? 1000000 : 100000000);
+    size_t max_threads = Benchmark::size_option(argc, argv, "max-threads", Benchmark::hardware_threads());
+    if (max_threads < 1)
+        max_threads = 1;
+
+    size_t sizes[max_sizes];
+    size_t size_count = 0;
+    for (size_t count = max_elements < 1000000 ? max_elements : 1000000; count <= max_elements && size_count < max_sizes; count *= 10)
+        sizes[size_count++] = count;
+
+    // The serial baselines run in this process, which never touches the algorithms' pool
+    double serial[algorithm_count][max_sizes];
+    Benchmark::print_title("Serial std algorithms on uint64_t (ms)");
+    print_sizes_header("");
+    for (size_t s = 0; s < size_count; s++) {
+        Buffers buffers;
+        fill(buffers, sizes[s]);
+        std::printf("%8s %12zu", "", sizes[s]);
+        for (size_t a = 0; a < algorithm_count; a++) {
+            serial[a][s] = measure(algorithms[a], buffers, algorithms[a].serial);
+            std::printf(" %14.2f", serial[a][s] * 1e3);
+        }
+        std::printf("\n");
+        std::fflush(stdout);
+    }
+
+    // The pool is sized once, when the first algorithm runs, so every thread count gets a process of its own
+    Benchmark::print_title("Parallel algorithms, speedup over the serial std algorithm");
+    print_sizes_header("threads");
+    std::fflush(stdout);
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count = Benchmark::next_thread_count(thread_count, max_threads)) {
+        pid_t child = fork();
+        if (child < 0) {
+            std::perror("fork");
+            return 1;
+        }
+        if (child == 0) {
+            set_parallel_thread_count(thread_count);
+            for (size_t s = 0; s < size_count; s++) {
+                Buffers buffers;
+                fill(buffers, sizes[s]);
+                std::printf("%8zu %12zu", thread_count, sizes[s]);
+                for (size_t a = 0; a < algorithm_count; a++)
+                    std::printf(" %14.2f", serial[a][s] / measure(algorithms[a], buffers, algorithms[a].parallel));
+                std::printf("\n");
+                std::fflush(stdout);
+            }
+            _exit(0);
+        }
+
+        int status = 0;
+        waitpid(child, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            std::fprintf(stderr, "the run with %zu threads failed\n", thread_count);
+            return 1;
+        }
+    }
+    return 0;
+}
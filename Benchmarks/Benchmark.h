@@ -0,0 +1,177 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+/* Benchmark Harness */
+// Every suite is a standalone program printing one table per measurement
+// Timings are the fastest of a few repetitions after a warm up run, which filters out most of the scheduling noise
+// `--quick` shrinks every suite to sizes that finish in seconds, `--name=value` options (with k, M and G suffixes) override single limits
+
+namespace Benchmark {
+
+using Clock = std::chrono::steady_clock;
+
+// Keeps the compiler from dropping a computation whose result is otherwise unused
+template<typename T>
+inline void do_not_optimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Forces pending stores to memory to be considered observed
+inline void clobber_memory()
+{
+    asm volatile("" : : : "memory");
+}
+
+inline double seconds_since(Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// Runs `body` once to warm caches and allocators up, then `repetitions` times, and returns the fastest run in seconds
+template<typename Body>
+double fastest_run(Body&& body, int repetitions = 5)
+{
+    body();
+
+    double fastest = 0;
+    for (int i = 0; i < repetitions; i++) {
+        Clock::time_point start = Clock::now();
+        body();
+        double elapsed = seconds_since(start);
+        if (i == 0 || elapsed < fastest)
+            fastest = elapsed;
+    }
+    return fastest;
+}
+
+// For bodies which consume their input, sorting for one: `setup()` prepares it again before every run and is not timed
+template<typename Setup, typename Body>
+double fastest_run_with_setup(Setup&& setup, Body&& body, int repetitions = 3)
+{
+    double fastest = 0;
+    for (int i = 0; i < repetitions; i++) {
+        setup();
+        Clock::time_point start = Clock::now();
+        body();
+        double elapsed = seconds_since(start);
+        if (i == 0 || elapsed < fastest)
+            fastest = elapsed;
+    }
+    return fastest;
+}
+
+// Same as `fastest_run()`, for bodies doing `operations` operations each, in nanoseconds per operation
+template<typename Body>
+double nanoseconds_per_operation(size_t operations, Body&& body, int repetitions = 5)
+{
+    return fastest_run(body, repetitions) * 1e9 / static_cast<double>(operations ? operations : 1);
+}
+
+// The sample below which `fraction` of the samples fall, reorders `samples`
+template<typename T>
+T percentile(std::vector<T>& samples, double fraction)
+{
+    if (samples.empty())
+        return T { };
+    size_t index = static_cast<size_t>(fraction * static_cast<double>(samples.size() - 1));
+    std::nth_element(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(index), samples.end());
+    return samples[index];
+}
+
+/* Command Line */
+
+inline bool has_flag(int argc, char** argv, const char* flag)
+{
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], flag) == 0)
+            return true;
+    }
+    return false;
+}
+
+inline bool is_quick(int argc, char** argv) { return has_flag(argc, argv, "--quick"); }
+
+// `--name=value`, where the value may end in k, M or G (powers of 1024 for sizes, which is what every suite counts)
+inline size_t size_option(int argc, char** argv, const char* name, size_t fallback)
+{
+    size_t name_length = std::strlen(name);
+    for (int i = 1; i < argc; i++) {
+        const char* argument = argv[i];
+        if (std::strncmp(argument, "--", 2) != 0 || std::strncmp(argument + 2, name, name_length) != 0 || argument[2 + name_length] != '=')
+            continue;
+
+        char* suffix = nullptr;
+        size_t value = std::strtoull(argument + 3 + name_length, &suffix, 10);
+        switch (*suffix) {
+        case 'k': case 'K': return value << 10;
+        case 'm': case 'M': return value << 20;
+        case 'g': case 'G': return value << 30;
+        default: return value;
+        }
+    }
+    return fallback;
+}
+
+inline size_t hardware_threads()
+{
+    size_t count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+// Doubles the thread count, and ends on `max_threads` itself when it is not a power of two
+inline size_t next_thread_count(size_t thread_count, size_t max_threads)
+{
+    if (thread_count < max_threads && thread_count * 2 > max_threads)
+        return max_threads;
+    return thread_count * 2;
+}
+
+// Best effort, pinning fails quietly where the platform does not support it or the CPU does not exist
+inline void pin_current_thread(size_t cpu)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu % hardware_threads(), &set);
+    pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+    (void)cpu;
+#endif
+}
+
+/* Reporting */
+
+inline void print_title(const char* title)
+{
+    std::printf("\n== %s ==\n", title);
+}
+
+inline const char* format_bytes(size_t bytes, char* buffer, size_t buffer_size)
+{
+    if (bytes >= (size_t(1) << 30) && bytes % (size_t(1) << 30) == 0)
+        std::snprintf(buffer, buffer_size, "%zu GiB", bytes >> 30);
+    else if (bytes >= (size_t(1) << 20) && bytes % (size_t(1) << 20) == 0)
+        std::snprintf(buffer, buffer_size, "%zu MiB", bytes >> 20);
+    else if (bytes >= (size_t(1) << 10) && bytes % (size_t(1) << 10) == 0)
+        std::snprintf(buffer, buffer_size, "%zu KiB", bytes >> 10);
+    else
+        std::snprintf(buffer, buffer_size, "%zu B", bytes);
+    return buffer;
+}
+
+}
@@ -0,0 +1,105 @@
+#include "Benchmark.h"
+#include "Deque.h"
+#include "List.h"
+#include <cstdint>
+
+namespace {
+
+struct Payload {
+    uint64_t values[8];
+
+    Payload() = default;
+    explicit Payload(size_t i) { values[0] = i; }
+    size_t key() const { return static_cast<size_t>(values[0]); }
+};
+
+size_t key_of(int value) { return static_cast<size_t>(value); }
+size_t key_of(const Payload& value) { return value.key(); }
+
+template<typename T>
+T make_value(size_t i)
+{
+    if constexpr (std::is_same<T, int>::value)
+        return static_cast<int>(i);
+    else
+        return Payload(i);
+}
+
+template<typename DequeType>
+void run_container(const char* container, const char* type_name, size_t count)
+{
+    using T = typename DequeType::ValueType;
+
+    double fill_back = Benchmark::nanoseconds_per_operation(count, [&] {
+        DequeType deque;
+        for (size_t i = 0; i < count; i++)
+            deque.push_back(make_value<T>(i));
+        while (!deque.empty())
+            deque.pop_front();
+    });
+
+    double fill_front = Benchmark::nanoseconds_per_operation(count, [&] {
+        DequeType deque;
+        for (size_t i = 0; i < count; i++)
+            deque.push_front(make_value<T>(i));
+        while (!deque.empty())
+            deque.pop_back();
+    });
+
+    // A queue at steady state: the window slides through the storage without growing it
+    double sliding = Benchmark::nanoseconds_per_operation(count, [&] {
+        DequeType deque;
+        for (size_t i = 0; i < 1024; i++)
+            deque.push_back(make_value<T>(i));
+        for (size_t i = 0; i < count; i++) {
+            deque.push_back(make_value<T>(i));
+            deque.pop_front();
+        }
+        Benchmark::do_not_optimize(deque.front());
+    });
+
+    DequeType deque;
+    for (size_t i = 0; i < count; i++) {
+        if (i % 2)
+            deque.push_back(make_value<T>(i));
+        else
+            deque.push_front(make_value<T>(i));
+    }
+    double iterate = Benchmark::nanoseconds_per_operation(count, [&] {
+        size_t sum = 0;
+        for (const T& value : deque)
+            sum += key_of(value);
+        Benchmark::do_not_optimize(sum);
+    });
+
+    char random_access[32] = "-";
+    if constexpr (requires(DequeType& d) { d[0]; }) {
+        double nanoseconds = Benchmark::nanoseconds_per_operation(count, [&] {
+            size_t sum = 0;
+            size_t index = 0;
+            for (size_t i = 0; i < count; i++) {
+                index = (index + 7919) % count;
+                sum += key_of(deque[index]);
+            }
+            Benchmark::do_not_optimize(sum);
+        });
+        std::snprintf(random_access, sizeof(random_access), "%.2f", nanoseconds);
+    }
+
+    std::printf("%-12s %-10s %14.2f %14.2f %14.2f %10.2f %14s\n", container, type_name, fill_back, fill_front, sliding, iterate, random_access);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = Benchmark::size_option(argc, argv, "elements", Benchmark::is_quick(argc, argv) ? 100000 : 4000000);
+
+    Benchmark::print_title("Deque: RingBuffer against List as the container (ns per element)");
+    std::printf("%-12s %-10s %14s %14s %14s %10s %14s\n", "container", "element", "push_back+pop", "push_front+pop", "sliding 1024", "iterate", "random access");
+    run_container<Deque<int>>("RingBuffer", "int", count);
+    run_container<Deque<int, List<int>>>("List", "int", count);
+    run_container<Deque<Payload>>("RingBuffer", "64 bytes", count);
+    run_container<Deque<Payload, List<Payload>>>("List", "64 bytes", count);
+    return 0;
+}
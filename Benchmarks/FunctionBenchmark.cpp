@@ -0,0 +1,116 @@
+#include "Benchmark.h"
+#include "Function.h"
+#include "OwnPtr.h"
+#include "Vector.h"
+
+// `Function` as it was before the inline storage: every callable on the heap behind an `OwnPtr`
+template<typename T>
+class HeapFunction;
+
+template<typename ReturnType, typename... ArgTypes>
+class HeapFunction<ReturnType (ArgTypes...)> {
+    class CallableWrapperBase {
+    public:
+        virtual ~CallableWrapperBase() = default;
+        virtual ReturnType invoke(ArgTypes... args) = 0;
+    };
+
+    template<typename CallableType>
+    class CallableWrapper final : public CallableWrapperBase {
+    public:
+        explicit CallableWrapper(CallableType&& callable)
+            : m_callable(TK::move(callable))
+        {
+        }
+
+        ReturnType invoke(ArgTypes... args) override { return m_callable(TK::forward<ArgTypes>(args)...); }
+
+    private:
+        CallableType m_callable;
+    };
+
+public:
+    HeapFunction() = default;
+
+    template<typename CallableType>
+    HeapFunction(CallableType&& callable)
+        : m_callable_wrapper(TK::make_own<CallableWrapper<std::decay_t<CallableType>>>(TK::forward<CallableType>(callable)))
+    {
+    }
+
+    ReturnType operator()(ArgTypes... args) const { return m_callable_wrapper->invoke(TK::forward<ArgTypes>(args)...); }
+
+private:
+    TK::OwnPtr<CallableWrapperBase> m_callable_wrapper { nullptr };
+};
+
+namespace {
+
+struct LargeCapture {
+    size_t values[8];
+};
+
+template<typename FunctionType, typename MakeCallable>
+void run_design(const char* design, const char* capture, size_t operations, MakeCallable make_callable)
+{
+    double construct = Benchmark::nanoseconds_per_operation(operations, [&] {
+        for (size_t i = 0; i < operations; i++) {
+            FunctionType function { make_callable(i) };
+            Benchmark::do_not_optimize(function);
+        }
+    });
+
+    FunctionType function { make_callable(1) };
+    double invoke = Benchmark::nanoseconds_per_operation(operations, [&] {
+        size_t sum = 0;
+        for (size_t i = 0; i < operations; i++)
+            sum += function(i);
+        Benchmark::do_not_optimize(sum);
+    });
+
+    // The pattern the callbacks are used in: many built, each run once, then all dropped
+    constexpr size_t batch = 10000;
+    double round_trip = Benchmark::nanoseconds_per_operation(operations, [&] {
+        Vector<FunctionType> callbacks;
+        callbacks.reserve(batch);
+        size_t sum = 0;
+        for (size_t done = 0; done < operations; done += batch) {
+            for (size_t i = 0; i < batch; i++)
+                callbacks.emplace_back(make_callable(i));
+            for (size_t i = 0; i < batch; i++)
+                sum += callbacks[i](i);
+            callbacks.clear();
+        }
+        Benchmark::do_not_optimize(sum);
+    });
+
+    std::printf("%-14s %-10s %16.2f %14.2f %24.2f\n", design, capture, construct, invoke, round_trip);
+}
+
+template<typename FunctionType>
+void run_captures(const char* design, size_t operations)
+{
+    run_design<FunctionType>(design, "empty", operations, [](size_t) { return [](size_t x) { return x + 1; }; });
+    run_design<FunctionType>(design, "2 words", operations, [](size_t i) {
+        size_t offset = i;
+        const size_t* base = &offset;
+        return [offset, base](size_t x) { return x + offset + (base != nullptr); };
+    });
+    run_design<FunctionType>(design, "64 bytes", operations, [](size_t i) {
+        LargeCapture capture { { i, i, i, i, i, i, i, i } };
+        return [capture](size_t x) { return x + capture.values[0] + capture.values[7]; };
+    });
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t operations = Benchmark::size_option(argc, argv, "operations", Benchmark::is_quick(argc, argv) ? 100000 : 2000000);
+
+    Benchmark::print_title("Function: inline storage against one heap allocation per callable (ns per operation)");
+    std::printf("%-14s %-10s %16s %14s %24s\n", "design", "capture", "construct+drop", "invoke", "build+invoke+drop x10k");
+    run_captures<HeapFunction<size_t(size_t)>>("heap (OwnPtr)", operations);
+    run_captures<TK::Function<size_t(size_t)>>("Function", operations);
+    return 0;
+}
@@ -0,0 +1,115 @@
+#include "Benchmark.h"
+#include "HashMap.h"
+#include "Vector.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+template<typename K, typename V>
+const V* lookup(const HashMap<K, V>& map, const K& key) { return map.get(key); }
+
+template<typename K, typename V>
+const V* lookup(const std::unordered_map<K, V>& map, const K& key)
+{
+    auto it = map.find(key);
+    return it == map.end() ? nullptr : &it->second;
+}
+
+template<typename K>
+K make_key(uint64_t value)
+{
+    if constexpr (std::is_same<K, std::string>::value)
+        return "key:" + std::to_string(value) + ":padding-past-sso";
+    else
+        return value;
+}
+
+// Keys present in the map and keys which are not, both in random order
+template<typename K>
+void make_keys(size_t count, Vector<K>& present, Vector<K>& missing)
+{
+    std::mt19937_64 random(count);
+    present.clear();
+    missing.clear();
+    for (size_t i = 0; i < count; i++) {
+        uint64_t value = random();
+        present.push_back(make_key<K>(value | 1));
+        missing.push_back(make_key<K>(value & ~uint64_t(1)));
+    }
+}
+
+template<typename MapType, typename K>
+void run_map(const char* map_name, const char* key_name, const Vector<K>& present, const Vector<K>& missing)
+{
+    size_t count = present.size();
+
+    double insert = Benchmark::nanoseconds_per_operation(count, [&] {
+        MapType map;
+        for (size_t i = 0; i < count; i++)
+            map.try_emplace(present[i], i);
+        Benchmark::do_not_optimize(map.size());
+    }, 3);
+
+    double insert_reserved = Benchmark::nanoseconds_per_operation(count, [&] {
+        MapType map;
+        map.reserve(count);
+        for (size_t i = 0; i < count; i++)
+            map.try_emplace(present[i], i);
+        Benchmark::do_not_optimize(map.size());
+    }, 3);
+
+    MapType map;
+    for (size_t i = 0; i < count; i++)
+        map.try_emplace(present[i], i);
+
+    auto lookups = [&](const Vector<K>& keys) {
+        return Benchmark::nanoseconds_per_operation(count, [&] {
+            size_t found = 0;
+            for (size_t i = 0; i < count; i++) {
+                if (const size_t* value = lookup(map, keys[count - 1 - i]))
+                    found += *value;
+            }
+            Benchmark::do_not_optimize(found);
+        });
+    };
+    double hits = lookups(present);
+    double misses = lookups(missing);
+
+    // Churn: every key erased and a new one inserted, then lookups again, which tombstones must not slow down
+    for (size_t i = 0; i < count; i++) {
+        map.erase(present[i]);
+        map.try_emplace(missing[i], i);
+    }
+    double hits_after_churn = lookups(missing);
+
+    std::printf("%-18s %-10s %10zu %10.1f %12.1f %10.1f %10.1f %16.1f\n", map_name, key_name, count, insert, insert_reserved, hits, misses, hits_after_churn);
+}
+
+template<typename K>
+void run_key(const char* key_name, size_t max_count)
+{
+    Vector<K> present;
+    Vector<K> missing;
+    for (size_t count = 1024; count <= max_count; count *= 32) {
+        make_keys(count, present, missing);
+        run_map<HashMap<K, size_t>>("HashMap", key_name, present, missing);
+        run_map<std::unordered_map<K, size_t>>("std::unordered_map", key_name, present, missing);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t max_count = Benchmark::size_option(argc, argv, "max-keys", Benchmark::is_quick(argc, argv) ? (size_t(1) << 15) : (size_t(1) << 20));
+
+    Benchmark::print_title("HashMap against std::unordered_map (ns per operation)");
+    std::printf("%-18s %-10s %10s %10s %12s %10s %10s %16s\n", "map", "key", "keys", "insert", "insert+rsv", "hit", "miss", "hit after churn");
+    run_key<uint64_t>("uint64_t", max_count);
+    run_key<std::string>("string", max_count);
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include "Benchmark.h"
+#include "List.h"
+#include "Vector.h"
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <random>
+
+namespace {
+
+struct Payload {
+    uint64_t key;
+    uint64_t padding[7];
+
+    Payload() = default;
+    explicit Payload(uint64_t value)
+        : key(value)
+    {
+    }
+
+    bool operator<(const Payload& other) const { return key < other.key; }
+};
+
+template<typename T>
+void fill(List<T>& list, std::list<T>& std_list, size_t count, uint64_t seed)
+{
+    std::mt19937_64 random(seed);
+    list.clear();
+    std_list.clear();
+    for (size_t i = 0; i < count; i++) {
+        T value(random() % (count * 4));
+        list.push_back(value);
+        std_list.push_back(value);
+    }
+}
+
+template<typename T>
+void run_type(const char* type_name, size_t max_count)
+{
+    for (size_t count = 10000; count <= max_count; count *= 10) {
+        List<T> list;
+        std::list<T> std_list;
+        size_t seed = 0;
+        auto refill = [&] { fill(list, std_list, count, ++seed); };
+
+        double list_sort = Benchmark::fastest_run_with_setup(refill, [&] { list.sort(); });
+        double std_list_sort = Benchmark::fastest_run_with_setup(refill, [&] { std_list.sort(); });
+
+        // The alternative to relinking: copy the values out, sort them contiguously, and write them back in order
+        double vector_sort = Benchmark::fastest_run_with_setup(refill, [&] {
+            Vector<T> values;
+            values.reserve(list.size());
+            for (const T& value : list)
+                values.push_back(value);
+            std::stable_sort(values.data(), values.data() + values.size());
+            size_t index = 0;
+            for (T& value : list)
+                value = values[index++];
+        });
+
+        // Two sorted halves merged into one, then the whole list reversed
+        List<T> other;
+        auto split = [&] {
+            refill();
+            list.sort();
+            other.clear();
+            bool odd = false;
+            for (auto it = list.begin(); it != list.end();) {
+                auto next = it;
+                ++next;
+                if ((odd = !odd))
+                    other.splice(other.end(), list, it);
+                it = next;
+            }
+        };
+        double merge = Benchmark::fastest_run_with_setup(split, [&] { list.merge(other); });
+        double reverse = Benchmark::fastest_run_with_setup(refill, [&] { list.reverse(); });
+
+        std::printf("%-10s %10zu %12.2f %14.2f %18.2f %12.2f %12.2f\n", type_name, count,
+            list_sort * 1e3, std_list_sort * 1e3, vector_sort * 1e3, merge * 1e3, reverse * 1e3);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t max_count = Benchmark::size_option(argc, argv, "max-elements", Benchmark::is_quick(argc, argv) ? 100000 : 1000000);
+
+    Benchmark::print_title("List: in-place merge sort against sorting a Vector copy (ms)");
+    std::printf("%-10s %10s %12s %14s %18s %12s %12s\n", "element", "nodes", "List::sort", "std::list", "Vector copy+sort", "merge", "reverse");
+    run_type<uint64_t>("uint64_t", max_count);
+    run_type<Payload>("64 bytes", max_count);
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "Benchmark.h"
+#include "MPMCQueue.h"
+#include "Vector.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr size_t queue_capacity = 1024;
+// One element in this many carries a timestamp into the latency samples
+constexpr size_t latency_stride = 16;
+
+struct Job {
+    int64_t pushed_at;
+    uint64_t payload;
+};
+
+inline int64_t now_nanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Benchmark::Clock::now().time_since_epoch()).count();
+}
+
+// What the workers were fed from before: a bounded std::deque behind a mutex and two condition variables
+class LockedQueue {
+public:
+    void push(const Job& job)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_full.wait(lock, [&] { return m_jobs.size() < queue_capacity; });
+        m_jobs.push_back(job);
+        lock.unlock();
+        m_not_empty.notify_one();
+    }
+
+    Job pop()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_not_empty.wait(lock, [&] { return !m_jobs.empty(); });
+        Job job = m_jobs.front();
+        m_jobs.pop_front();
+        lock.unlock();
+        m_not_full.notify_one();
+        return job;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_not_full;
+    std::condition_variable m_not_empty;
+    std::deque<Job> m_jobs;
+};
+
+// Non-blocking variants with the retry loop a caller would write around them
+struct SpinningQueue {
+    void push(const Job& job)
+    {
+        while (!m_queue.try_push(job))
+            std::this_thread::yield();
+    }
+
+    Job pop()
+    {
+        Job job;
+        while (!m_queue.try_pop(job))
+            std::this_thread::yield();
+        return job;
+    }
+
+    MPMCQueue<Job, queue_capacity> m_queue;
+};
+
+struct Result {
+    double seconds;
+    double p50_nanoseconds;
+    double p99_nanoseconds;
+};
+
+// `side_count` producers and as many consumers, every producer pushes `per_producer` jobs
+template<typename QueueType>
+Result run(size_t side_count, size_t per_producer)
+{
+    QueueType queue;
+    Vector<std::vector<double>> samples;
+    samples.resize(side_count);
+
+    std::atomic<size_t> ready { 0 };
+    std::atomic<bool> go { false };
+    auto wait_for_go = [&](size_t cpu) {
+        Benchmark::pin_current_thread(cpu);
+        ready.fetch_add(1);
+        while (!go.load(std::memory_order_acquire))
+            std::this_thread::yield();
+    };
+
+    Vector<std::thread> threads;
+    for (size_t i = 0; i < side_count; i++) {
+        threads.push_back(std::thread([&, i] {
+            wait_for_go(i * 2);
+            for (size_t n = 0; n < per_producer; n++)
+                queue.push(Job { n % latency_stride ? 0 : now_nanoseconds(), n });
+        }));
+        threads.push_back(std::thread([&, i] {
+            wait_for_go(i * 2 + 1);
+            std::vector<double>& latencies = samples[i];
+            latencies.reserve(per_producer / latency_stride + 1);
+            uint64_t sum = 0;
+            for (size_t n = 0; n < per_producer; n++) {
+                Job job = queue.pop();
+                if (job.pushed_at)
+                    latencies.push_back(static_cast<double>(now_nanoseconds() - job.pushed_at));
+                sum += job.payload;
+            }
+            Benchmark::do_not_optimize(sum);
+        }));
+    }
+
+    while (ready.load() != threads.size())
+        std::this_thread::yield();
+    Benchmark::Clock::time_point start = Benchmark::Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+        thread.join();
+    double seconds = Benchmark::seconds_since(start);
+
+    std::vector<double> all;
+    for (auto& latencies : samples)
+        all.insert(all.end(), latencies.begin(), latencies.end());
+    double p50 = Benchmark::percentile(all, 0.5);
+    double p99 = Benchmark::percentile(all, 0.99);
+    return { seconds, p50, p99 };
+}
+
+template<typename QueueType>
+void run_design(const char* design, size_t max_threads, size_t jobs)
+{
+    for (size_t thread_count = 2; thread_count <= max_threads; thread_count = Benchmark::next_thread_count(thread_count, max_threads)) {
+        size_t side_count = thread_count / 2;
+        size_t per_producer = jobs / side_count;
+        Result result = run<QueueType>(side_count, per_producer);
+        double total = static_cast<double>(per_producer * side_count);
+        std::printf("%-24s %8zu %8zu %14.2f %12.0f %12.0f\n", design, side_count, side_count,
+            total / result.seconds / 1e6, result.p50_nanoseconds, result.p99_nanoseconds);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t jobs = Benchmark::size_option(argc, argv, "jobs", quick ? 200000 : 4000000);
+    size_t max_threads = Benchmark::size_option(argc, argv, "max-threads", quick ? 8 : 64);
+    if (max_threads < 2)
+        max_threads = 2;
+
+    if (Benchmark::hardware_threads() < max_threads)
+        std::printf("%zu CPUs for up to %zu threads: the larger rows oversubscribe, which is where blocking matters\n", Benchmark::hardware_threads(), max_threads);
+
+    Benchmark::print_title("MPMCQueue fan-out: producers push jobs, consumers pop them (threads = producers + consumers)");
+    std::printf("%-24s %8s %8s %14s %12s %12s\n", "design", "push", "pop", "M jobs/s", "p50 ns", "p99 ns");
+    run_design<MPMCQueue<Job, queue_capacity>>("MPMCQueue push/pop", max_threads, jobs);
+    run_design<SpinningQueue>("MPMCQueue try_ + yield", max_threads, jobs);
+    run_design<LockedQueue>("mutex + condvar", max_threads, jobs);
+    return 0;
+}
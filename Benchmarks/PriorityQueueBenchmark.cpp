@@ -0,0 +1,114 @@
+#include "Benchmark.h"
+#include "PriorityQueue.h"
+#include "Vector.h"
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+
+namespace {
+
+struct Timer {
+    uint64_t deadline;
+    uint64_t id;
+
+    bool operator>(const Timer& other) const { return deadline > other.deadline; }
+};
+
+// Earliest deadline first
+using TimerQueue = PriorityQueue<Timer, std::greater<Timer>>;
+
+Vector<Timer> make_timers(size_t count)
+{
+    std::mt19937_64 random(count);
+    Vector<Timer> timers;
+    timers.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        timers.push_back(Timer { random() % (count * 16), i });
+    return timers;
+}
+
+void run_startup(size_t count)
+{
+    Vector<Timer> timers = make_timers(count);
+    Vector<Timer> input;
+    auto copy_input = [&] { input = timers; };
+
+    double push_each = Benchmark::fastest_run_with_setup(copy_input, [&] {
+        TimerQueue queue;
+        for (size_t i = 0; i < count; i++)
+            queue.push(input[i]);
+        Benchmark::do_not_optimize(queue.top());
+    });
+
+    double adopt = Benchmark::fastest_run_with_setup(copy_input, [&] {
+        TimerQueue queue(TK::move(input));
+        Benchmark::do_not_optimize(queue.top());
+    });
+
+    double push_bulk = Benchmark::fastest_run_with_setup(copy_input, [&] {
+        TimerQueue queue;
+        queue.push_bulk(input);
+        Benchmark::do_not_optimize(queue.top());
+    });
+
+    // Half loaded up front, the other half added in one batch later on
+    double push_bulk_half = Benchmark::fastest_run_with_setup(copy_input, [&] {
+        TimerQueue queue;
+        for (size_t i = 0; i < count / 2; i++)
+            queue.push(input[i]);
+        queue.push_bulk(Vector<Timer>(input.begin() + count / 2, input.end()));
+        Benchmark::do_not_optimize(queue.top());
+    });
+
+    std::vector<Timer> std_input;
+    double std_heapify = Benchmark::fastest_run_with_setup([&] { std_input.assign(timers.data(), timers.data() + count); }, [&] {
+        std::priority_queue<Timer, std::vector<Timer>, std::greater<Timer>> queue(std::greater<Timer>(), TK::move(std_input));
+        Benchmark::do_not_optimize(queue.top());
+    });
+
+    std::printf("%10zu %12.2f %14.2f %12.2f %22.2f %20.2f\n", count, push_each * 1e3, adopt * 1e3, push_bulk * 1e3, push_bulk_half * 1e3, std_heapify * 1e3);
+}
+
+void run_drain(size_t count)
+{
+    Vector<Timer> timers = make_timers(count);
+    TimerQueue queue;
+    auto fill = [&] { queue = TimerQueue(Vector<Timer>(timers)); };
+
+    double pop_each = Benchmark::fastest_run_with_setup(fill, [&] {
+        Vector<Timer> expired;
+        expired.reserve(count);
+        while (!queue.is_empty())
+            expired.push_back(queue.pop());
+        Benchmark::do_not_optimize(expired.data());
+    });
+
+    double pop_batches = Benchmark::fastest_run_with_setup(fill, [&] {
+        Vector<Timer> expired;
+        expired.reserve(count);
+        while (!queue.is_empty())
+            queue.pop_n(256, expired);
+        Benchmark::do_not_optimize(expired.data());
+    });
+
+    std::printf("%10zu %12.2f %16.2f\n", count, pop_each * 1e3, pop_batches * 1e3);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t max_count = Benchmark::size_option(argc, argv, "max-timers", Benchmark::is_quick(argc, argv) ? 100000 : 10000000);
+
+    Benchmark::print_title("PriorityQueue startup: loading n timers (ms)");
+    std::printf("%10s %12s %14s %12s %22s %20s\n", "timers", "push each", "adopt Vector", "push_bulk", "push half + bulk half", "std::priority_queue");
+    for (size_t count = 10000; count <= max_count; count *= 10)
+        run_startup(count);
+
+    Benchmark::print_title("PriorityQueue drain: popping every timer (ms)");
+    std::printf("%10s %12s %16s\n", "timers", "pop each", "pop_n(256)");
+    for (size_t count = 10000; count <= max_count; count *= 10)
+        run_drain(count);
+    return 0;
+}
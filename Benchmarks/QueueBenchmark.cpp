@@ -0,0 +1,108 @@
+#include "Benchmark.h"
+#include "List.h"
+#include "Queue.h"
+#include <cstdint>
+#include <new>
+#include <queue>
+
+// Counts every global allocation, to check that a queue at its working size stops allocating
+static size_t s_allocations = 0;
+
+void* operator new(size_t size)
+{
+    s_allocations++;
+    if (void* ptr = std::malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+    s_allocations++;
+    size_t align = static_cast<size_t>(alignment);
+    if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { std::free(ptr); }
+
+namespace {
+
+template<size_t bytes>
+struct Element {
+    uint64_t words[bytes / sizeof(uint64_t)];
+
+    Element() = default;
+    explicit Element(size_t i) { words[0] = i; }
+};
+
+// Takes anything with `push(T&&)`, `pop()` and a `value_type`, which covers `std::queue` as the reference
+template<typename QueueType>
+void run_queue(const char* queue_name, const char* element_name, size_t operations)
+{
+    using T = typename QueueType::value_type;
+
+    // Bursts: fill up, then drain
+    constexpr size_t burst = 4096;
+    double bursts = Benchmark::nanoseconds_per_operation(operations, [&] {
+        QueueType queue;
+        for (size_t done = 0; done < operations; done += burst) {
+            for (size_t i = 0; i < burst; i++)
+                queue.push(T(i));
+            for (size_t i = 0; i < burst; i++)
+                queue.pop();
+        }
+    });
+
+    // Steady state: the producer stays a fixed distance ahead of the consumer
+    size_t steady_allocations = 0;
+    double steady = Benchmark::nanoseconds_per_operation(operations, [&] {
+        QueueType queue;
+        // One more push than the window, so that the queue has grown to its working size before counting starts
+        for (size_t i = 0; i < 256; i++)
+            queue.push(T(i));
+        queue.push(T(0));
+        queue.pop();
+        size_t allocations_before = s_allocations;
+        for (size_t i = 0; i < operations; i++) {
+            queue.push(T(i));
+            queue.pop();
+        }
+        steady_allocations = s_allocations - allocations_before;
+    });
+
+    std::printf("%-16s %-10s %14.1f %14.1f %18zu\n", queue_name, element_name, 1e3 / bursts, 1e3 / steady, steady_allocations);
+}
+
+// Gives every queue the standard spelling the runner uses
+template<typename T, typename Container = RingBuffer<T>>
+struct TKQueue : Queue<T, Container> {
+    using value_type = T;
+};
+
+template<size_t bytes>
+void run_element(const char* element_name, size_t operations)
+{
+    using T = Element<bytes>;
+    run_queue<TKQueue<T>>("Queue", element_name, operations);
+    run_queue<TKQueue<T, List<T>>>("Queue<List>", element_name, operations);
+    run_queue<std::queue<T>>("std::queue", element_name, operations);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t operations = Benchmark::size_option(argc, argv, "operations", Benchmark::is_quick(argc, argv) ? 1 << 18 : 1 << 24);
+
+    Benchmark::print_title("Queue FIFO throughput (million push + pop pairs per second)");
+    std::printf("%-16s %-10s %14s %14s %18s\n", "queue", "element", "bursts of 4096", "steady 256", "steady allocations");
+    run_element<8>("8 bytes", operations);
+    run_element<64>("64 bytes", operations);
+    run_element<256>("256 bytes", operations);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "AtomicRefCounted.h"
+#include "Benchmark.h"
+#include "Ref.h"
+#include "RefCounted.h"
+#include "RefPtr.h"
+#include "Vector.h"
+#include <atomic>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// On a cache line of its own, so that per-thread objects do not false share
+struct alignas(64) SharedObject : TK::AtomicRefCounted<SharedObject> {
+    int value { 1 };
+};
+
+struct LocalObject : TK::RefCounted<LocalObject> {
+    int value { 1 };
+};
+
+// Runs `body(thread_index)` on `thread_count` threads released together, and returns the wall time until the last one finishes
+template<typename Body>
+double run_threads(size_t thread_count, Body&& body)
+{
+    std::atomic<size_t> ready { 0 };
+    std::atomic<bool> go { false };
+    Vector<std::thread> threads;
+    for (size_t i = 0; i < thread_count; i++) {
+        threads.push_back(std::thread([&, i] {
+            Benchmark::pin_current_thread(i);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire))
+                ;
+            body(i);
+        }));
+    }
+
+    while (ready.load() != thread_count)
+        std::this_thread::yield();
+    Benchmark::Clock::time_point start = Benchmark::Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads)
+        thread.join();
+    return Benchmark::seconds_since(start);
+}
+
+template<typename Pointer>
+void copy_and_drop(const Pointer& shared, size_t copies)
+{
+    for (size_t i = 0; i < copies; i++) {
+        Pointer copy = shared;
+        Benchmark::do_not_optimize(copy);
+    }
+}
+
+void print_row(const char* design, size_t thread_count, size_t copies, double seconds)
+{
+    double total = static_cast<double>(copies * thread_count);
+    std::printf("%-30s %8zu %16.1f %20.2f\n", design, thread_count, total / seconds / 1e6, seconds * 1e9 / static_cast<double>(copies));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t copies = Benchmark::size_option(argc, argv, "copies", quick ? 200000 : 10000000);
+    size_t max_threads = Benchmark::size_option(argc, argv, "max-threads", Benchmark::hardware_threads());
+
+    Benchmark::print_title("RefPtr copy + drop under contention (all threads share one object unless noted)");
+    std::printf("%-30s %8s %16s %20s\n", "design", "threads", "M copies/s total", "ns per copy, thread");
+
+    {
+        TK::RefPtr<LocalObject> local = TK::make_ref<LocalObject>();
+        double seconds = Benchmark::fastest_run([&] { copy_and_drop(local, copies); }, 3);
+        print_row("RefCounted (single thread)", 1, copies, seconds);
+    }
+
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count = Benchmark::next_thread_count(thread_count, max_threads)) {
+        TK::RefPtr<SharedObject> shared = TK::make_ref<SharedObject>();
+        print_row("AtomicRefCounted", thread_count, copies,
+            run_threads(thread_count, [&](size_t) { copy_and_drop(shared, copies); }));
+
+        // The same count traffic without the shared cache line, the cost of the atomics alone
+        Vector<TK::RefPtr<SharedObject>> own;
+        for (size_t i = 0; i < thread_count; i++)
+            own.push_back(TK::make_ref<SharedObject>());
+        print_row("AtomicRefCounted, own objects", thread_count, copies,
+            run_threads(thread_count, [&](size_t index) { copy_and_drop(own[index], copies); }));
+
+        std::shared_ptr<SharedObject> std_shared = std::make_shared<SharedObject>();
+        print_row("std::shared_ptr", thread_count, copies,
+            run_threads(thread_count, [&](size_t) { copy_and_drop(std_shared, copies); }));
+    }
+    return 0;
+}
@@ -0,0 +1,190 @@
+#include "Benchmark.h"
+#include "SIMD.h"
+#include "Vector.h"
+#include <cstdint>
+#include <random>
+
+namespace {
+
+// The scalar reference loop, every vector level called directly, and the public entry point which dispatches on the CPU
+enum class Variant {
+    Scalar,
+    Baseline,
+    AVX2,
+    AVX512,
+    Dispatch,
+};
+
+constexpr Variant variants[] = { Variant::Scalar, Variant::Baseline, Variant::AVX2, Variant::AVX512, Variant::Dispatch };
+
+bool is_supported(Variant variant)
+{
+#if TK_SIMD_X86_DISPATCH
+    if (variant == Variant::AVX2)
+        return TK::SIMD::level() >= TK::SIMD::Level::AVX2;
+    if (variant == Variant::AVX512)
+        return TK::SIMD::level() == TK::SIMD::Level::AVX512;
+    return true;
+#else
+    return variant != Variant::AVX2 && variant != Variant::AVX512;
+#endif
+}
+
+#if TK_SIMD_X86_DISPATCH
+#define BENCHMARK_SIMD_WIDE_LEVELS(kernel, ...)                  \
+    case Variant::AVX2:                                         \
+        return TK::SIMD::Internal::kernel##_avx2(__VA_ARGS__);   \
+    case Variant::AVX512:                                       \
+        return TK::SIMD::Internal::kernel##_avx512(__VA_ARGS__);
+#else
+#define BENCHMARK_SIMD_WIDE_LEVELS(kernel, ...)
+#endif
+
+#define BENCHMARK_SIMD_SWITCH(variant, scalar_call, kernel, ...)        \
+    switch (variant) {                                                 \
+    case Variant::Scalar:                                              \
+        return TK::SIMD::Internal::ScalarKernels<T>::scalar_call;       \
+    case Variant::Baseline:                                            \
+        return TK::SIMD::Internal::kernel##_baseline(__VA_ARGS__);      \
+        BENCHMARK_SIMD_WIDE_LEVELS(kernel, __VA_ARGS__)                \
+    default:                                                           \
+        return TK::SIMD::kernel(__VA_ARGS__);                           \
+    }
+
+template<typename T>
+size_t run_find(Variant variant, const T* data, size_t count, T value) { BENCHMARK_SIMD_SWITCH(variant, find(data, count, value), find, data, count, value) }
+
+template<typename T>
+size_t run_count(Variant variant, const T* data, size_t count, T value) { BENCHMARK_SIMD_SWITCH(variant, count(data, count, value), count, data, count, value) }
+
+template<typename T>
+bool run_equal(Variant variant, const T* lhs, const T* rhs, size_t count) { BENCHMARK_SIMD_SWITCH(variant, equal(lhs, rhs, count), equal, lhs, rhs, count) }
+
+template<typename T>
+T run_min(Variant variant, const T* data, size_t count) { BENCHMARK_SIMD_SWITCH(variant, min(data, count, data[0], 1), min, data, count) }
+
+template<typename T>
+T run_max(Variant variant, const T* data, size_t count) { BENCHMARK_SIMD_SWITCH(variant, max(data, count, data[0], 1), max, data, count) }
+
+template<typename T>
+void run_fill(Variant variant, T* data, size_t count, T value) { BENCHMARK_SIMD_SWITCH(variant, fill(data, count, value), fill, data, count, value) }
+
+#undef BENCHMARK_SIMD_SWITCH
+#undef BENCHMARK_SIMD_WIDE_LEVELS
+
+// Every element below `absent`, so that find and count scan the whole buffer
+template<typename T>
+void make_data(Vector<T>& data, size_t count, T& absent)
+{
+    std::mt19937_64 random(count);
+    data.clear();
+    data.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        if constexpr (std::is_floating_point<T>::value)
+            data.push_back(static_cast<T>(random() % 1000000) / T(1000000));
+        else if constexpr (sizeof(T) == 1)
+            data.push_back(static_cast<T>(random() % 127));
+        else
+            data.push_back(static_cast<T>(random() % 1000000));
+    }
+    absent = static_cast<T>(127);
+    if constexpr (std::is_floating_point<T>::value)
+        absent = T(2);
+    else if constexpr (sizeof(T) > 1)
+        absent = static_cast<T>(2000000);
+}
+
+// Repeats `body` over the same buffer until about `bytes_per_run` went through it, and returns GB/s
+template<typename Body>
+double gigabytes_per_second(size_t bytes_per_call, size_t bytes_per_run, Body&& body)
+{
+    size_t calls = bytes_per_run / bytes_per_call;
+    if (calls == 0)
+        calls = 1;
+    double seconds = Benchmark::fastest_run([&] {
+        for (size_t i = 0; i < calls; i++)
+            body();
+    }, 3);
+    return static_cast<double>(bytes_per_call * calls) / seconds / 1e9;
+}
+
+template<typename Body>
+void print_row(const char* type_name, const char* kernel, size_t bytes, size_t bytes_touched, size_t bytes_per_run, Body&& body)
+{
+    char size[32];
+    std::printf("%-8s %-10s %10s", type_name, kernel, Benchmark::format_bytes(bytes, size, sizeof(size)));
+    for (Variant variant : variants) {
+        if (is_supported(variant))
+            std::printf(" %10.2f", gigabytes_per_second(bytes_touched, bytes_per_run, [&] { body(variant); }));
+        else
+            std::printf(" %10s", "-");
+    }
+    std::printf("\n");
+}
+
+template<typename T>
+void run_type(const char* type_name, const size_t* sizes, size_t size_count, size_t bytes_per_run)
+{
+    for (size_t s = 0; s < size_count; s++) {
+        size_t bytes = sizes[s];
+        size_t count = bytes / sizeof(T);
+        Vector<T> data;
+        T absent;
+        make_data(data, count, absent);
+        Vector<T> copy = data;
+        Vector<T> target(count);
+        T fill_value = static_cast<T>(0x5A);
+
+        print_row(type_name, "find", bytes, bytes, bytes_per_run, [&](Variant variant) {
+            Benchmark::do_not_optimize(run_find(variant, data.data(), count, absent));
+        });
+        print_row(type_name, "count", bytes, bytes, bytes_per_run, [&](Variant variant) {
+            Benchmark::do_not_optimize(run_count(variant, data.data(), count, absent));
+        });
+        print_row(type_name, "equal", bytes, 2 * bytes, bytes_per_run, [&](Variant variant) {
+            Benchmark::do_not_optimize(run_equal(variant, data.data(), copy.data(), count));
+        });
+        print_row(type_name, "min", bytes, bytes, bytes_per_run, [&](Variant variant) {
+            Benchmark::do_not_optimize(run_min(variant, data.data(), count));
+        });
+        print_row(type_name, "max", bytes, bytes, bytes_per_run, [&](Variant variant) {
+            Benchmark::do_not_optimize(run_max(variant, data.data(), count));
+        });
+        print_row(type_name, "fill", bytes, bytes, bytes_per_run, [&](Variant variant) {
+            run_fill(variant, target.data(), count, fill_value);
+            Benchmark::clobber_memory();
+        });
+    }
+}
+
+const char* level_name(TK::SIMD::Level level)
+{
+    switch (level) {
+    case TK::SIMD::Level::Scalar: return "scalar";
+    case TK::SIMD::Level::Baseline: return "baseline";
+    case TK::SIMD::Level::AVX2: return "AVX2";
+    case TK::SIMD::Level::AVX512: return "AVX-512";
+    }
+    return "?";
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t bytes_per_run = Benchmark::size_option(argc, argv, "bytes-per-run", quick ? (size_t(32) << 20) : (size_t(256) << 20));
+    // In L1, in L2, and well past the last level cache
+    const size_t sizes[] = { size_t(16) << 10, size_t(256) << 10, size_t(64) << 20 };
+    size_t size_count = quick ? 2 : 3;
+
+    char title[128];
+    std::snprintf(title, sizeof(title), "SIMD kernels, GB/s of data read or written (this CPU dispatches to %s)", level_name(TK::SIMD::level()));
+    Benchmark::print_title(title);
+    std::printf("%-8s %-10s %10s %10s %10s %10s %10s %10s\n", "type", "kernel", "buffer", "scalar", "baseline", "AVX2", "AVX-512", "dispatch");
+    run_type<uint8_t>("uint8_t", sizes, size_count, bytes_per_run);
+    run_type<int32_t>("int32_t", sizes, size_count, bytes_per_run);
+    run_type<float>("float", sizes, size_count, bytes_per_run);
+    run_type<double>("double", sizes, size_count, bytes_per_run);
+    return 0;
+}
@@ -0,0 +1,226 @@
+#include "Benchmark.h"
+#include "SPSCQueue.h"
+#include "Vector.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+constexpr size_t queue_capacity = 1024;
+constexpr size_t batch_size = 64;
+
+// Spins a little before giving the CPU away, which keeps both sides making progress when they share a core
+inline void backoff(unsigned& spins)
+{
+    if (++spins < 64)
+        return;
+    spins = 0;
+    std::this_thread::yield();
+}
+
+// The producer on CPU 0 and the consumer on CPU 1, released together, returns the wall time until both finish
+template<typename Producer, typename Consumer>
+double run_pair(Producer&& producer, Consumer&& consumer)
+{
+    std::atomic<int> ready { 0 };
+    std::atomic<bool> go { false };
+    auto start_when_released = [&](size_t cpu, auto& body) {
+        return std::thread([&, cpu] {
+            Benchmark::pin_current_thread(cpu);
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire))
+                std::this_thread::yield();
+            body();
+        });
+    };
+    std::thread producer_thread = start_when_released(0, producer);
+    std::thread consumer_thread = start_when_released(1, consumer);
+
+    while (ready.load() != 2)
+        std::this_thread::yield();
+    Benchmark::Clock::time_point start = Benchmark::Clock::now();
+    go.store(true, std::memory_order_release);
+    producer_thread.join();
+    consumer_thread.join();
+    return Benchmark::seconds_since(start);
+}
+
+double spsc_single(size_t count)
+{
+    SPSCQueue<uint64_t, queue_capacity> queue;
+    uint64_t sum = 0;
+    double seconds = run_pair(
+        [&] {
+            unsigned spins = 0;
+            for (uint64_t i = 0; i < count; i++) {
+                while (!queue.try_push(i))
+                    backoff(spins);
+            }
+        },
+        [&] {
+            unsigned spins = 0;
+            uint64_t value;
+            for (size_t i = 0; i < count; i++) {
+                while (!queue.try_pop(value))
+                    backoff(spins);
+                sum += value;
+            }
+        });
+    Benchmark::do_not_optimize(sum);
+    return seconds;
+}
+
+double spsc_batched(size_t count)
+{
+    SPSCQueue<uint64_t, queue_capacity> queue;
+    uint64_t sum = 0;
+    double seconds = run_pair(
+        [&] {
+            unsigned spins = 0;
+            uint64_t batch[batch_size];
+            for (size_t sent = 0; sent < count;) {
+                size_t wanted = count - sent < batch_size ? count - sent : batch_size;
+                for (size_t i = 0; i < wanted; i++)
+                    batch[i] = sent + i;
+                for (size_t pushed = 0; pushed < wanted;) {
+                    size_t done = queue.try_push_n(batch + pushed, wanted - pushed);
+                    if (!done)
+                        backoff(spins);
+                    pushed += done;
+                }
+                sent += wanted;
+            }
+        },
+        [&] {
+            unsigned spins = 0;
+            uint64_t batch[batch_size];
+            for (size_t received = 0; received < count;) {
+                size_t done = queue.try_pop_n(batch, batch_size);
+                if (!done)
+                    backoff(spins);
+                for (size_t i = 0; i < done; i++)
+                    sum += batch[i];
+                received += done;
+            }
+        });
+    Benchmark::do_not_optimize(sum);
+    return seconds;
+}
+
+// What the pipeline stages did before: a std::deque behind a mutex, bounded the same way
+double mutex_queue(size_t count)
+{
+    std::mutex mutex;
+    std::deque<uint64_t> queue;
+    uint64_t sum = 0;
+    double seconds = run_pair(
+        [&] {
+            unsigned spins = 0;
+            for (uint64_t i = 0; i < count;) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (queue.size() < queue_capacity) {
+                        queue.push_back(i++);
+                        continue;
+                    }
+                }
+                backoff(spins);
+            }
+        },
+        [&] {
+            unsigned spins = 0;
+            for (size_t i = 0; i < count;) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    if (!queue.empty()) {
+                        sum += queue.front();
+                        queue.pop_front();
+                        i++;
+                        continue;
+                    }
+                }
+                backoff(spins);
+            }
+        });
+    Benchmark::do_not_optimize(sum);
+    return seconds;
+}
+
+// Ping-pong over a pair of queues, one round trip per sample
+void round_trips(size_t count, std::vector<double>& samples)
+{
+    SPSCQueue<uint64_t, queue_capacity> ping;
+    SPSCQueue<uint64_t, queue_capacity> pong;
+    samples.clear();
+    samples.reserve(count);
+    run_pair(
+        [&] {
+            unsigned spins = 0;
+            uint64_t value;
+            for (uint64_t i = 0; i < count; i++) {
+                Benchmark::Clock::time_point start = Benchmark::Clock::now();
+                ping.try_push(i);
+                while (!pong.try_pop(value))
+                    backoff(spins);
+                samples.push_back(Benchmark::seconds_since(start) * 1e9);
+            }
+        },
+        [&] {
+            unsigned spins = 0;
+            uint64_t value;
+            for (size_t i = 0; i < count; i++) {
+                while (!ping.try_pop(value))
+                    backoff(spins);
+                pong.try_push(value);
+            }
+        });
+}
+
+// The threads time themselves, so that starting and joining them stays out of the measurement
+template<typename Run>
+double fastest_pair_run(Run&& run, size_t count)
+{
+    double fastest = 0;
+    for (int i = 0; i < 3; i++) {
+        double seconds = run(count);
+        if (i == 0 || seconds < fastest)
+            fastest = seconds;
+    }
+    return fastest;
+}
+
+void print_throughput(const char* design, size_t count, double seconds)
+{
+    std::printf("%-26s %12zu %14.1f %12.2f\n", design, count, static_cast<double>(count) / seconds / 1e6, seconds * 1e9 / static_cast<double>(count));
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t count = Benchmark::size_option(argc, argv, "elements", quick ? 1000000 : 50000000);
+    size_t trips = Benchmark::size_option(argc, argv, "round-trips", quick ? 10000 : 1000000);
+
+    if (Benchmark::hardware_threads() < 2)
+        std::printf("Only one CPU: producer and consumer share it, so these numbers measure the scheduler as much as the queue\n");
+
+    Benchmark::print_title("SPSCQueue throughput, producer on CPU 0 and consumer on CPU 1");
+    std::printf("%-26s %12s %14s %12s\n", "design", "elements", "M elements/s", "ns/element");
+    print_throughput("SPSCQueue try_push/pop", count, fastest_pair_run(spsc_single, count));
+    print_throughput("SPSCQueue try_push_n/pop_n", count, fastest_pair_run(spsc_batched, count));
+    print_throughput("mutex + std::deque", count, fastest_pair_run(mutex_queue, count));
+
+    Benchmark::print_title("SPSCQueue round trip latency (ns)");
+    std::vector<double> samples;
+    round_trips(trips, samples);
+    double median = Benchmark::percentile(samples, 0.5);
+    double p99 = Benchmark::percentile(samples, 0.99);
+    double p999 = Benchmark::percentile(samples, 0.999);
+    std::printf("%12s %12s %12s %12s\n", "round trips", "median", "p99", "p99.9");
+    std::printf("%12zu %12.0f %12.0f %12.0f\n", trips, median, p99, p999);
+    return 0;
+}
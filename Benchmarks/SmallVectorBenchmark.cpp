@@ -0,0 +1,75 @@
+#include "Allocator.h"
+#include "Benchmark.h"
+#include "Vector.h"
+
+namespace {
+
+size_t s_allocations = 0;
+
+// Counts the heap blocks a container asks for, on top of the global heap
+struct CountingAllocator {
+    void* allocate(size_t size, size_t alignment)
+    {
+        s_allocations++;
+        return DefaultAllocator().allocate(size, alignment);
+    }
+
+    void deallocate(void* ptr, size_t size, size_t alignment) { DefaultAllocator().deallocate(ptr, size, alignment); }
+
+    bool operator==(const CountingAllocator&) const { return true; }
+};
+
+constexpr size_t inline_capacity = 8;
+
+template<typename T>
+using CountingVector = Vector<T, ToolKit::DoublingGrowth, size_t, 0, CountingAllocator>;
+template<typename T>
+using CountingSmallVector = Vector<T, ToolKit::DoublingGrowth, size_t, inline_capacity, CountingAllocator>;
+
+// Builds `count` short-lived vectors of `length` elements each, the way temporaries are used: filled, read once, dropped
+template<typename VectorType>
+size_t fill_and_drop(size_t count, size_t length)
+{
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        VectorType values;
+        for (size_t j = 0; j < length; j++)
+            values.emplace_back(static_cast<int>(i + j));
+        for (size_t j = 0; j < values.size(); j++)
+            total += static_cast<size_t>(values[j]);
+    }
+    return total;
+}
+
+template<typename VectorType>
+double allocations_per_vector(size_t count, size_t length)
+{
+    s_allocations = 0;
+    Benchmark::do_not_optimize(fill_and_drop<VectorType>(count, length));
+    return static_cast<double>(s_allocations) / static_cast<double>(count);
+}
+
+template<typename VectorType>
+double nanoseconds_per_vector(size_t count, size_t length)
+{
+    return Benchmark::nanoseconds_per_operation(count, [&] { Benchmark::do_not_optimize(fill_and_drop<VectorType>(count, length)); });
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    size_t count = Benchmark::size_option(argc, argv, "vectors", Benchmark::is_quick(argc, argv) ? 20000 : 1000000);
+
+    Benchmark::print_title("Short-lived vectors of int: SmallVector<int, 8> against Vector<int>");
+    std::printf("%-8s %18s %18s %16s %16s\n", "length", "Vector allocs", "SmallVector allocs", "Vector ns", "SmallVector ns");
+    for (size_t length : { 1, 2, 4, 7, 8, 9, 16, 64 }) {
+        // Latency is measured with the default allocator, which is what `SmallVector` uses
+        std::printf("%-8zu %18.2f %18.2f %16.1f %16.1f\n", length,
+            allocations_per_vector<CountingVector<int>>(count, length),
+            allocations_per_vector<CountingSmallVector<int>>(count, length),
+            nanoseconds_per_vector<Vector<int>>(count, length),
+            nanoseconds_per_vector<SmallVector<int, inline_capacity>>(count, length));
+    }
+    return 0;
+}
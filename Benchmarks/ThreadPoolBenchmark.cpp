@@ -0,0 +1,119 @@
+#include "Benchmark.h"
+#include "ThreadPool.h"
+#include "Vector.h"
+#include <atomic>
+#include <cstdint>
+
+namespace {
+
+uint64_t serial_sum(const uint64_t* values, size_t first, size_t last)
+{
+    uint64_t sum = 0;
+    for (size_t i = first; i < last; i++)
+        sum += values[i];
+    return sum;
+}
+
+uint64_t serial_fib(unsigned n)
+{
+    return n < 2 ? n : serial_fib(n - 1) + serial_fib(n - 2);
+}
+
+// Forks both halves of the recursion as a nested `parallel_for` until `n` falls to the cutoff, below which it recurses serially
+uint64_t parallel_fib(ThreadPool& pool, unsigned n, unsigned cutoff)
+{
+    if (n <= cutoff)
+        return serial_fib(n);
+
+    uint64_t results[2];
+    pool.parallel_for(0, 2, 1, [&](size_t index) { results[index] = parallel_fib(pool, n - 1 - static_cast<unsigned>(index), cutoff); });
+    return results[0] + results[1];
+}
+
+void run_sum(const Vector<uint64_t>& values, size_t max_threads)
+{
+    size_t count = values.size();
+    double serial = Benchmark::fastest_run([&] { Benchmark::do_not_optimize(serial_sum(values.data(), 0, count)); });
+
+    static constexpr size_t grains[] = { 1024, 16384, 262144, 4194304 };
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count = Benchmark::next_thread_count(thread_count, max_threads)) {
+        ThreadPool pool(thread_count);
+        for (size_t grain : grains) {
+            if (grain > count)
+                break;
+            double seconds = Benchmark::fastest_run([&] {
+                std::atomic<uint64_t> total { 0 };
+                pool.parallel_for(0, count, grain, [&](size_t first, size_t last) {
+                    total.fetch_add(serial_sum(values.data(), first, last), std::memory_order_relaxed);
+                });
+                Benchmark::do_not_optimize(total.load());
+            });
+            std::printf("%8zu %10zu %12zu %12.2f %12.2f %10.2f\n", thread_count, count, grain, seconds * 1e3,
+                static_cast<double>(count * sizeof(uint64_t)) / seconds / 1e9, serial / seconds);
+        }
+    }
+}
+
+void run_fib(unsigned n, size_t max_threads)
+{
+    double serial = Benchmark::fastest_run([&] { Benchmark::do_not_optimize(serial_fib(n)); }, 3);
+
+    static constexpr unsigned cutoffs[] = { 5, 10, 15, 20, 25 };
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count = Benchmark::next_thread_count(thread_count, max_threads)) {
+        ThreadPool pool(thread_count);
+        for (unsigned cutoff : cutoffs) {
+            if (cutoff >= n)
+                break;
+            double seconds = Benchmark::fastest_run([&] { Benchmark::do_not_optimize(parallel_fib(pool, n, cutoff)); }, 3);
+            // Every fork below the top splits into two tasks, one of which is submitted
+            double forks = static_cast<double>(serial_fib(n - cutoff + 1));
+            std::printf("%8zu %6u %8u %12.2f %14.0f %10.2f\n", thread_count, n, cutoff, seconds * 1e3, forks, serial / seconds);
+        }
+    }
+}
+
+void run_submit(size_t tasks, size_t max_threads)
+{
+    for (size_t thread_count = 1; thread_count <= max_threads; thread_count = Benchmark::next_thread_count(thread_count, max_threads)) {
+        ThreadPool pool(thread_count);
+        std::atomic<size_t> ran { 0 };
+        double nanoseconds = Benchmark::nanoseconds_per_operation(tasks, [&] {
+            for (size_t i = 0; i < tasks; i++)
+                pool.submit([&ran] { ran.fetch_add(1, std::memory_order_relaxed); });
+            pool.wait_idle();
+        });
+        Benchmark::do_not_optimize(ran.load());
+        std::printf("%8zu %12zu %16.1f\n", thread_count, tasks, nanoseconds);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t elements = Benchmark::size_option(argc, argv, "elements", quick ? (size_t(1) << 20) : (size_t(1) << 24));
+    size_t fib = Benchmark::size_option(argc, argv, "fib", quick ? 25 : 32);
+    size_t tasks = Benchmark::size_option(argc, argv, "tasks", quick ? 100000 : 1000000);
+    size_t max_threads = Benchmark::size_option(argc, argv, "max-threads", Benchmark::hardware_threads());
+    if (max_threads < 1)
+        max_threads = 1;
+
+    Vector<uint64_t> values;
+    values.reserve(elements);
+    for (size_t i = 0; i < elements; i++)
+        values.push_back(i * 2654435761u);
+
+    Benchmark::print_title("ThreadPool parallel_for sum (speedup over a serial loop)");
+    std::printf("%8s %10s %12s %12s %12s %10s\n", "threads", "elements", "grain", "ms", "GB/s", "speedup");
+    run_sum(values, max_threads);
+
+    Benchmark::print_title("ThreadPool recursive fib, nested parallel_for down to a serial cutoff (speedup over serial recursion)");
+    std::printf("%8s %6s %8s %12s %14s %10s\n", "threads", "n", "cutoff", "ms", "forks", "speedup");
+    run_fib(static_cast<unsigned>(fib), max_threads);
+
+    Benchmark::print_title("ThreadPool submit + wait_idle from outside the pool");
+    std::printf("%8s %12s %16s\n", "threads", "tasks", "ns per task");
+    run_submit(tasks, max_threads);
+    return 0;
+}
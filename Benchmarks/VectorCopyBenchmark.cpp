@@ -0,0 +1,84 @@
+#include "Benchmark.h"
+#include "Vector.h"
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// Repeats `body` until about `bytes_per_run` went through it, and returns GB/s
+template<typename Body>
+double gigabytes_per_second(size_t bytes_per_call, size_t bytes_per_run, Body&& body)
+{
+    size_t calls = bytes_per_run / bytes_per_call;
+    if (calls == 0)
+        calls = 1;
+    double seconds = Benchmark::fastest_run([&] {
+        for (size_t i = 0; i < calls; i++)
+            body();
+    }, 3);
+    return static_cast<double>(bytes_per_call * calls) / seconds / 1e9;
+}
+
+void run_size(size_t bytes, size_t bytes_per_run)
+{
+    size_t count = bytes / sizeof(uint64_t);
+    Vector<uint64_t> source;
+    source.reserve(count);
+    for (size_t i = 0; i < count; i++)
+        source.push_back(i * 0x9E3779B97F4A7C15ull);
+
+    // Copies into memory which is already there and touched
+    double memcpy_rate;
+    double assign_rate;
+    {
+        Vector<uint64_t> target(count);
+        memcpy_rate = gigabytes_per_second(bytes, bytes_per_run, [&] {
+            std::memcpy(target.data(), source.data(), bytes);
+            Benchmark::clobber_memory();
+        });
+        assign_rate = gigabytes_per_second(bytes, bytes_per_run, [&] {
+            target = source;
+            Benchmark::clobber_memory();
+        });
+    }
+
+    // Copies into a fresh allocation, which large sizes pay page faults for
+    double copy_rate = gigabytes_per_second(bytes, bytes_per_run, [&] {
+        Vector<uint64_t> copy(source);
+        Benchmark::do_not_optimize(copy.data());
+    });
+
+    double std_copy_rate;
+    {
+        std::vector<uint64_t> std_source(source.data(), source.data() + count);
+        std_copy_rate = gigabytes_per_second(bytes, bytes_per_run, [&] {
+            std::vector<uint64_t> copy(std_source);
+            Benchmark::do_not_optimize(copy.data());
+        });
+    }
+
+    double fill_rate = gigabytes_per_second(bytes, bytes_per_run, [&] {
+        Vector<uint64_t> filled(count, 0x0101010101010101ull);
+        Benchmark::do_not_optimize(filled.data());
+    });
+
+    char size[32];
+    std::printf("%10s %10.2f %14.2f %12.2f %16.2f %16.2f\n", Benchmark::format_bytes(bytes, size, sizeof(size)),
+        memcpy_rate, assign_rate, copy_rate, std_copy_rate, fill_rate);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t max_bytes = Benchmark::size_option(argc, argv, "max-bytes", quick ? (size_t(64) << 20) : (size_t(1) << 30));
+    size_t bytes_per_run = Benchmark::size_option(argc, argv, "bytes-per-run", quick ? (size_t(64) << 20) : (size_t(512) << 20));
+
+    Benchmark::print_title("Vector<uint64_t> copies against memcpy (GB/s)");
+    std::printf("%10s %10s %14s %12s %16s %16s\n", "size", "memcpy", "Vector::op=", "Vector(copy)", "std::vector copy", "Vector(n, value)");
+    for (size_t bytes = size_t(4) << 10; bytes <= max_bytes; bytes *= 4)
+        run_size(bytes, bytes_per_run);
+    return 0;
+}
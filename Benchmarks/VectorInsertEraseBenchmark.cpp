@@ -0,0 +1,85 @@
+#include "Benchmark.h"
+#include "Vector.h"
+#include <string>
+#include <vector>
+
+namespace {
+
+template<typename T>
+T make_value(size_t i)
+{
+    if constexpr (std::is_same<T, std::string>::value)
+        return std::string(24, static_cast<char>('a' + i % 26));
+    else
+        return static_cast<T>(i);
+}
+
+// Inserts `count` elements in the middle of a `base_size` vector and erases them again, in microseconds per insert + erase pair
+template<typename T>
+void run_type(const char* type_name, size_t base_size, size_t repetitions)
+{
+    Vector<T> base;
+    std::vector<T> std_base;
+    for (size_t i = 0; i < base_size; i++) {
+        base.push_back(make_value<T>(i));
+        std_base.push_back(make_value<T>(i));
+    }
+
+    for (size_t count : { 1, 10, 100, 1000, 10000 }) {
+        Vector<T> range;
+        std::vector<T> std_range;
+        for (size_t i = 0; i < count; i++) {
+            range.push_back(make_value<T>(i));
+            std_range.push_back(make_value<T>(i));
+        }
+        T value = make_value<T>(7);
+
+        double range_insert = Benchmark::nanoseconds_per_operation(repetitions, [&] {
+            for (size_t i = 0; i < repetitions; i++) {
+                base.insert(base.begin() + base_size / 2, range.begin(), range.end());
+                base.erase(base.begin() + base_size / 2, base.begin() + base_size / 2 + count);
+            }
+        }, 3) / 1000;
+
+        double count_insert = Benchmark::nanoseconds_per_operation(repetitions, [&] {
+            for (size_t i = 0; i < repetitions; i++) {
+                base.insert(base.begin() + base_size / 2, count, value);
+                base.erase(base.begin() + base_size / 2, base.begin() + base_size / 2 + count);
+            }
+        }, 3) / 1000;
+
+        double std_range_insert = Benchmark::nanoseconds_per_operation(repetitions, [&] {
+            for (size_t i = 0; i < repetitions; i++) {
+                std_base.insert(std_base.begin() + base_size / 2, std_range.begin(), std_range.end());
+                std_base.erase(std_base.begin() + base_size / 2, std_base.begin() + base_size / 2 + count);
+            }
+        }, 3) / 1000;
+
+        // One element at a time, the O(n * k) pattern bulk shifting replaces, repeated less as it gets slow
+        size_t single_repetitions = count >= 1000 ? 1 : repetitions;
+        double single_inserts = Benchmark::nanoseconds_per_operation(single_repetitions, [&] {
+            for (size_t i = 0; i < single_repetitions; i++) {
+                for (size_t j = 0; j < count; j++)
+                    base.insert(base.begin() + base_size / 2, value);
+                base.erase(base.begin() + base_size / 2, base.begin() + base_size / 2 + count);
+            }
+        }, 1) / 1000;
+
+        std::printf("%-12s %8zu %14.2f %14.2f %18.2f %20.2f\n", type_name, count, range_insert, count_insert, std_range_insert, single_inserts);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t base_size = Benchmark::size_option(argc, argv, "base-size", quick ? 10000 : 100000);
+    size_t repetitions = Benchmark::size_option(argc, argv, "repetitions", quick ? 5 : 20);
+
+    Benchmark::print_title("Vector: insert k elements in the middle and erase them again (us per insert + erase)");
+    std::printf("%-12s %8s %14s %14s %18s %20s\n", "type", "k", "range insert", "count insert", "std::vector range", "k single inserts");
+    run_type<int>("int", base_size, repetitions);
+    run_type<std::string>("std::string", base_size, repetitions);
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "Benchmark.h"
+#include "Vector.h"
+#include <cstdint>
+
+// A narrow `SizeType` only shrinks the vector header, which pays off when vectors are themselves packed in large arrays
+template<typename Size>
+using SizedVector = Vector<uint32_t, ToolKit::DoublingGrowth, Size>;
+
+namespace {
+
+template<typename Size>
+void run_nested(const char* name, size_t outer_count)
+{
+    Vector<SizedVector<Size>> buckets;
+    buckets.reserve(outer_count);
+    for (size_t i = 0; i < outer_count; i++) {
+        buckets.emplace_back();
+        // Most buckets stay empty, the point is the cost of looking at the headers
+        if (i % 8 == 0)
+            buckets.back().push_back(static_cast<uint32_t>(i));
+    }
+
+    double scan = Benchmark::nanoseconds_per_operation(outer_count, [&] {
+        size_t total = 0;
+        for (size_t i = 0; i < outer_count; i++) {
+            const SizedVector<Size>& bucket = buckets[i];
+            total += bucket.size();
+            if (!bucket.empty())
+                total += bucket[0];
+        }
+        Benchmark::do_not_optimize(total);
+    });
+
+    char bytes[32];
+    std::printf("%-10s %14zu %16s %20.3f\n", name, sizeof(SizedVector<Size>),
+        Benchmark::format_bytes(outer_count * sizeof(SizedVector<Size>), bytes, sizeof(bytes)), scan);
+}
+
+template<typename Size>
+void run_append(const char* name, size_t count)
+{
+    double append = Benchmark::nanoseconds_per_operation(count, [&] {
+        SizedVector<Size> values;
+        for (size_t i = 0; i < count; i++)
+            values.push_back(static_cast<uint32_t>(i));
+        Benchmark::do_not_optimize(values.data());
+    });
+
+    SizedVector<Size> values;
+    for (size_t i = 0; i < count; i++)
+        values.push_back(static_cast<uint32_t>(i));
+    double indexed_sum = Benchmark::nanoseconds_per_operation(count, [&] {
+        uint64_t sum = 0;
+        for (Size i = 0; i < values.size(); i++)
+            sum += values[i];
+        Benchmark::do_not_optimize(sum);
+    });
+
+    std::printf("%-10s %18.3f %18.3f\n", name, append, indexed_sum);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    bool quick = Benchmark::is_quick(argc, argv);
+    size_t outer_count = Benchmark::size_option(argc, argv, "vectors", quick ? (size_t(1) << 18) : (size_t(1) << 24));
+    size_t element_count = Benchmark::size_option(argc, argv, "elements", quick ? (size_t(1) << 20) : (size_t(1) << 26));
+
+    Benchmark::print_title("Vector of vectors: header scan by SizeType (ns per inner vector)");
+    std::printf("%-10s %14s %16s %20s\n", "SizeType", "sizeof(Vector)", "headers", "scan size + front");
+    run_nested<size_t>("size_t", outer_count);
+    run_nested<uint32_t>("uint32_t", outer_count);
+
+    Benchmark::print_title("Single vector of uint32_t by SizeType (ns per element)");
+    std::printf("%-10s %18s %18s\n", "SizeType", "push_back", "indexed sum");
+    run_append<size_t>("size_t", element_count);
+    run_append<uint32_t>("uint32_t", element_count);
+    return 0;
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "Definitions.h"
+#include "ThreadPool.h"
+#include "Utility.h"
+#include "Vector.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+namespace TK {
+
+namespace Internal {
+
+// Blocks fit comfortably in L2, so each task streams through data it owns while the neighbouring blocks go to other cores
+static constexpr size_t parallel_block_bytes = 64 * 1024;
+
+inline std::atomic<size_t> parallel_serial_threshold { 32 * 1024 };
+
+// Zero for a thread per core, only read when the pool is created
+inline std::atomic<size_t> parallel_thread_count { 0 };
+
+// Never destroyed, like the object pools, so that algorithms running from static destructors still find it
+inline ThreadPool& parallel_pool()
+{
+    static ThreadPool* pool = [] {
+        size_t thread_count = parallel_thread_count.load(std::memory_order_relaxed);
+        return new ThreadPool(thread_count ? thread_count : ThreadPool::default_thread_count());
+    }();
+    return *pool;
+}
+
+// Vector's iterators and plain pointers alike, the algorithms only ever work on contiguous memory
+template<typename It>
+ALWAYS_INLINE auto address_of(It it)
+{
+    if constexpr (std::is_pointer<It>::value)
+        return it;
+    else
+        return it.operator->();
+}
+
+template<typename T>
+constexpr size_t parallel_block_size() { return sizeof(T) < parallel_block_bytes ? parallel_block_bytes / sizeof(T) : 1; }
+
+template<typename T>
+bool runs_serially(size_t count) { return count < parallel_serial_threshold.load(std::memory_order_relaxed) || count <= parallel_block_size<T>(); }
+
+// Calls `body(first, last)` for every block of `count` elements, on the pool
+template<typename T, typename Body>
+void for_each_block(size_t count, Body&& body)
+{
+    constexpr size_t block_size = parallel_block_size<T>();
+    size_t blocks = (count + block_size - 1) / block_size;
+    parallel_pool().parallel_for(0, blocks, 1, [&](size_t block) {
+        size_t first = block * block_size;
+        body(first, count - first < block_size ? count : first + block_size);
+    });
+}
+
+// How many elements of `a` come first in the first `rank` elements of their stable merge with `b`
+template<typename T, typename Compare>
+size_t merge_split(const T* a, size_t a_size, const T* b, size_t b_size, size_t rank, Compare& compare)
+{
+    size_t low = rank > b_size ? rank - b_size : 0;
+    size_t high = rank < a_size ? rank : a_size;
+    while (low < high) {
+        size_t middle = low + (high - low) / 2;
+        if (!compare(b[rank - middle - 1], a[middle]))
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+} // namespace Internal
+
+/* Parallel Algorithms */
+// Run on a process-wide `ThreadPool` over contiguous ranges, `Vector` iterators or pointers, split into cache sized blocks
+// Ranges shorter than the serial threshold are not worth waking the pool up for and run on the calling thread
+// `reduce` and `inclusive_scan` regroup the operations, so their operator must be associative
+
+inline size_t parallel_serial_threshold() { return Internal::parallel_serial_threshold.load(std::memory_order_relaxed); }
+inline void set_parallel_serial_threshold(size_t count) { Internal::parallel_serial_threshold.store(count, std::memory_order_relaxed); }
+
+// Sizes the pool the algorithms run on, which only works before the first of them wakes it up, zero restores a thread per core
+inline void set_parallel_thread_count(size_t count) { Internal::parallel_thread_count.store(count, std::memory_order_relaxed); }
+
+template<typename It, typename Function>
+void parallel_for_each(It first, It last, Function function)
+{
+    auto* data = Internal::address_of(first);
+    size_t count = static_cast<size_t>(last - first);
+    using T = std::remove_reference_t<decltype(*data)>;
+
+    auto run = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            function(data[i]);
+    };
+
+    if (Internal::runs_serially<T>(count))
+        run(0, count);
+    else
+        Internal::for_each_block<T>(count, run);
+}
+
+// `out` may be `first` itself
+template<typename It, typename OutputIt, typename Function>
+OutputIt parallel_transform(It first, It last, OutputIt out, Function function)
+{
+    auto* data = Internal::address_of(first);
+    auto* output = Internal::address_of(out);
+    size_t count = static_cast<size_t>(last - first);
+    using T = std::remove_reference_t<decltype(*data)>;
+
+    auto run = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            output[i] = function(data[i]);
+    };
+
+    if (Internal::runs_serially<T>(count))
+        run(0, count);
+    else
+        Internal::for_each_block<T>(count, run);
+    return out + static_cast<decltype(out - out)>(count);
+}
+
+template<typename It, typename T, typename Operation = std::plus<>>
+T parallel_reduce(It first, It last, T init, Operation operation = Operation())
+{
+    auto* data = Internal::address_of(first);
+    size_t count = static_cast<size_t>(last - first);
+    using ElementType = std::remove_reference_t<decltype(*data)>;
+
+    if (Internal::runs_serially<ElementType>(count)) {
+        for (size_t i = 0; i < count; i++)
+            init = operation(TK::move(init), data[i]);
+        return init;
+    }
+
+    // Every block reduces into a partial of its own, which are then folded in order
+    constexpr size_t block_size = Internal::parallel_block_size<ElementType>();
+    size_t blocks = (count + block_size - 1) / block_size;
+    Vector<T> partials(blocks);
+    Internal::for_each_block<ElementType>(count, [&](size_t begin, size_t end) {
+        T partial = data[begin];
+        for (size_t i = begin + 1; i < end; i++)
+            partial = operation(TK::move(partial), data[i]);
+        partials[begin / block_size] = TK::move(partial);
+    });
+
+    for (size_t i = 0; i < blocks; i++)
+        init = operation(TK::move(init), TK::move(partials[i]));
+    return init;
+}
+
+// Blocks are summed up in parallel, their offsets are scanned on the calling thread, then the blocks are scanned in parallel from their offsets
+// `out` may be `first` itself
+template<typename It, typename OutputIt, typename Operation = std::plus<>>
+OutputIt parallel_inclusive_scan(It first, It last, OutputIt out, Operation operation = Operation())
+{
+    auto* data = Internal::address_of(first);
+    auto* output = Internal::address_of(out);
+    size_t count = static_cast<size_t>(last - first);
+    using T = std::remove_cvref_t<decltype(*data)>;
+    auto end = out + static_cast<decltype(out - out)>(count);
+
+    if (count == 0)
+        return end;
+
+    auto scan = [&](size_t begin, size_t end, T accumulator) {
+        for (size_t i = begin; i < end; i++) {
+            accumulator = operation(TK::move(accumulator), data[i]);
+            output[i] = accumulator;
+        }
+    };
+
+    if (Internal::runs_serially<T>(count)) {
+        output[0] = data[0];
+        scan(1, count, data[0]);
+        return end;
+    }
+
+    constexpr size_t block_size = Internal::parallel_block_size<T>();
+    size_t blocks = (count + block_size - 1) / block_size;
+    Vector<T> totals(blocks);
+    Internal::for_each_block<T>(count, [&](size_t begin, size_t end) {
+        T total = data[begin];
+        for (size_t i = begin + 1; i < end; i++)
+            total = operation(TK::move(total), data[i]);
+        totals[begin / block_size] = TK::move(total);
+    });
+
+    // Turns each total into the offset its block starts from, everything before it
+    for (size_t i = 1; i < blocks; i++)
+        totals[i] = operation(totals[i - 1], totals[i]);
+
+    Internal::for_each_block<T>(count, [&](size_t begin, size_t end) {
+        size_t block = begin / block_size;
+        T start = block ? operation(totals[block - 1], data[begin]) : data[begin];
+        output[begin] = start;
+        scan(begin + 1, end, TK::move(start));
+    });
+    return end;
+}
+
+// A merge sort: blocks are sorted in parallel, then merged pairwise through a buffer until one run is left
+// Every merge is itself split at cache sized output boundaries, so the last passes keep all workers busy too
+// Not stable, elements must be default constructible and move assignable
+template<typename It, typename Compare = std::less<>>
+void parallel_sort(It first, It last, Compare compare = Compare())
+{
+    auto* data = Internal::address_of(first);
+    size_t count = static_cast<size_t>(last - first);
+    using T = std::remove_reference_t<decltype(*data)>;
+
+    if (Internal::runs_serially<T>(count)) {
+        std::sort(data, data + count, compare);
+        return;
+    }
+
+    Internal::for_each_block<T>(count, [&](size_t begin, size_t end) { std::sort(data + begin, data + end, compare); });
+
+    constexpr size_t block_size = Internal::parallel_block_size<T>();
+    Vector<T> buffer(count);
+    T* source = data;
+    T* target = &buffer[0];
+
+    for (size_t width = block_size; width < count; width *= 2) {
+        // Every output block belongs to one pair of runs, and finds the elements it merges from by binary search
+        Internal::for_each_block<T>(count, [&](size_t begin, size_t end) {
+            size_t pair = begin / (2 * width) * (2 * width);
+            size_t a_size = count - pair < width ? count - pair : width;
+            size_t b_size = count - pair - a_size < width ? count - pair - a_size : width;
+            const T* a = source + pair;
+            const T* b = a + a_size;
+
+            size_t a_begin = Internal::merge_split(a, a_size, b, b_size, begin - pair, compare);
+            size_t a_end = Internal::merge_split(a, a_size, b, b_size, end - pair, compare);
+            std::merge(std::make_move_iterator(a + a_begin), std::make_move_iterator(a + a_end),
+                std::make_move_iterator(b + (begin - pair - a_begin)), std::make_move_iterator(b + (end - pair - a_end)),
+                target + begin, compare);
+        });
+        TK::swap(source, target);
+    }
+
+    if (source != data) {
+        Internal::for_each_block<T>(count, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++)
+                data[i] = TK::move(source[i]);
+        });
+    }
+}
+
+// Moves the elements satisfying `predicate` before the others, keeping the relative order within both groups, and returns the boundary
+// Elements must be default constructible and move assignable
+template<typename It, typename Predicate>
+It parallel_partition(It first, It last, Predicate predicate)
+{
+    auto* data = Internal::address_of(first);
+    size_t count = static_cast<size_t>(last - first);
+    using T = std::remove_reference_t<decltype(*data)>;
+
+    if (Internal::runs_serially<T>(count))
+        return first + (std::stable_partition(data, data + count, predicate) - data);
+
+    // The predicate runs once per element, its verdicts are kept for the scatter
+    constexpr size_t block_size = Internal::parallel_block_size<T>();
+    size_t blocks = (count + block_size - 1) / block_size;
+    Vector<unsigned char> verdicts(count);
+    Vector<size_t> selected(blocks);
+    Internal::for_each_block<T>(count, [&](size_t begin, size_t end) {
+        size_t block_selected = 0;
+        for (size_t i = begin; i < end; i++) {
+            verdicts[i] = predicate(data[i]) ? 1 : 0;
+            block_selected += verdicts[i];
+        }
+        selected[begin / block_size] = block_selected;
+    });
+
+    // Exclusive prefix sums give every block the positions its elements scatter to
+    size_t total_selected = 0;
+    for (size_t i = 0; i < blocks; i++) {
+        size_t block_selected = selected[i];
+        selected[i] = total_selected;
+        total_selected += block_selected;
+    }
+
+    Vector<T> buffer(count);
+    Internal::for_each_block<T>(count, [&](size_t begin, size_t end) {
+        size_t selected_position = selected[begin / block_size];
+        size_t rejected_position = total_selected + (begin - selected_position);
+        for (size_t i = begin; i < end; i++) {
+            if (verdicts[i])
+                buffer[selected_position++] = TK::move(data[i]);
+            else
+                buffer[rejected_position++] = TK::move(data[i]);
+        }
+    });
+
+    Internal::for_each_block<T>(count, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            data[i] = TK::move(buffer[i]);
+    });
+    return first + static_cast<decltype(first - first)>(total_selected);
+}
+
+}
+
+using TK::parallel_for_each;
+using TK::parallel_inclusive_scan;
+using TK::parallel_partition;
+using TK::parallel_reduce;
+using TK::parallel_serial_threshold;
+using TK::parallel_sort;
+using TK::parallel_transform;
+using TK::set_parallel_serial_threshold;
+using TK::set_parallel_thread_count;
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Definitions.h"
+#include <cstddef>
+#include <new>
+
+namespace TK {
+
+// Containers taking an `Allocator` parameter only rely on
+//     void* allocate(size_t size, size_t alignment);
+//     void deallocate(void* ptr, size_t size, size_t alignment);
+//     bool operator==(const Allocator&) const;
+// Two allocators comparing equal can free each other's memory, which lets containers hand nodes over to each other
+
+/* Global Heap Allocator */
+struct DefaultAllocator {
+    ALWAYS_INLINE void* allocate(size_t size, size_t alignment)
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            return ::operator new(size, std::align_val_t(alignment));
+        return ::operator new(size);
+    }
+
+    ALWAYS_INLINE void deallocate(void* ptr, size_t size, size_t alignment)
+    {
+        if (alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__)
+            ::operator delete(ptr, size, std::align_val_t(alignment));
+        else
+            ::operator delete(ptr, size);
+    }
+
+    bool operator==(const DefaultAllocator&) const { return true; }
+};
+
+}
+
+using TK::DefaultAllocator;
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "Assertions.h"
+#include "Definitions.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "OwnPtr.h"
+#include "Utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+#if !defined(TK_ARENA_HAS_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#define TK_ARENA_HAS_MMAP 1
+#endif
+
+#if !defined(TK_ARENA_HAS_MMAP)
+#define TK_ARENA_HAS_MMAP 0
+#endif
+
+#if TK_ARENA_HAS_MMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace TK {
+
+class Arena;
+
+enum class ArenaBacking {
+    Heap, // Chunks come from `operator new`
+    Mmap, // Chunks are mapped straight from the kernel, falls back to the heap where `mmap` is unavailable
+};
+
+// Lets `OwnPtr` own an object living in an `Arena`, dropping it runs the destructor early but leaves the memory to the arena
+struct ArenaDelete {
+    Arena* m_arena { nullptr };
+
+    template<typename T>
+    void operator()(T* ptr) const;
+};
+
+/* Arena Allocator */
+// Memory is bumped out of large chunks and given back all at once, by `reset()`, `rewind()` or the destruction of the arena
+// Objects made by `make()` are destroyed in reverse order at that point, those trivially destructible are not even tracked
+// Chunks are kept across `reset()` and `rewind()`, so an arena reused for every request stops allocating after the first few
+class Arena {
+    TK_MAKE_NONCOPYABLE(Arena)
+    TK_MAKE_NONMOVABLE(Arena)
+
+    struct Chunk;
+    struct DestructorNode;
+
+public:
+    static constexpr size_t default_chunk_size = 64 * 1024;
+
+    // A position of the arena, everything allocated after it is given back by `rewind()`
+    class Mark {
+        friend Arena;
+
+        Chunk* m_chunk { nullptr };
+        unsigned char* m_position { nullptr };
+        DestructorNode* m_destructors { nullptr };
+    };
+
+public:
+    explicit Arena(size_t chunk_size = default_chunk_size, ArenaBacking backing = ArenaBacking::Heap)
+        : m_chunk_size(chunk_size)
+        , m_backing(backing)
+    {
+    }
+
+    ~Arena()
+    {
+        run_destructors(nullptr);
+        release_chunks();
+    }
+
+    // `alignment` must be a power of two
+    ALWAYS_INLINE void* allocate(size_t size, size_t alignment = alignof(std::max_align_t))
+    {
+        ASSERT((alignment & (alignment - 1)) == 0);
+        uintptr_t address = align_up(reinterpret_cast<uintptr_t>(m_position), alignment);
+        if (address + size > reinterpret_cast<uintptr_t>(m_end) || !m_position) [[unlikely]]
+            return allocate_slow(size, alignment);
+
+        m_position = reinterpret_cast<unsigned char*>(address + size);
+        return reinterpret_cast<void*>(address);
+    }
+
+    // Only the latest allocation can be given back, anything else waits for `rewind()` or `reset()`
+    ALWAYS_INLINE void deallocate(void* ptr, size_t size)
+    {
+        if (ptr && static_cast<unsigned char*>(ptr) + size == m_position)
+            m_position = static_cast<unsigned char*>(ptr);
+    }
+
+    template<typename T, typename... Args>
+    T* make(Args&&... args)
+    {
+        void* memory = allocate(sizeof(T), alignof(T));
+        if constexpr (std::is_trivially_destructible<T>::value) {
+            return new (memory) T(TK::forward<Args>(args)...);
+        } else {
+            void* node_memory = allocate(sizeof(DestructorNode), alignof(DestructorNode));
+            T* object = new (memory) T(TK::forward<Args>(args)...);
+            m_destructors = new (node_memory) DestructorNode { [](void* ptr) { static_cast<T*>(ptr)->~T(); }, object, m_destructors };
+            return object;
+        }
+    }
+
+    // The `OwnPtr` destroys the object when dropped, so the arena does not keep track of it
+    template<typename T, typename... Args>
+    OwnPtr<T, ArenaDelete> make_own(Args&&... args)
+    {
+        void* memory = allocate(sizeof(T), alignof(T));
+        return OwnPtr<T, ArenaDelete> { new (memory) T(TK::forward<Args>(args)...), ArenaDelete { this } };
+    }
+
+    [[nodiscard]] Mark mark() const
+    {
+        Mark mark;
+        mark.m_chunk = m_current;
+        mark.m_position = m_position;
+        mark.m_destructors = m_destructors;
+        return mark;
+    }
+
+    // Destroys the objects made since `mark` and reuses their memory, the chunks stay around
+    void rewind(const Mark& mark)
+    {
+        run_destructors(mark.m_destructors);
+        m_current = mark.m_chunk;
+        m_position = mark.m_position;
+        m_end = m_current ? m_current->end() : nullptr;
+    }
+
+    void reset() { rewind(Mark { }); }
+
+    // Chunk memory held by the arena, whether in use or not
+    [[nodiscard]] size_t bytes_reserved() const { return m_bytes_reserved; }
+
+private:
+    struct Chunk {
+        Chunk* m_next;
+        size_t m_size;
+        bool m_mapped;
+
+        unsigned char* begin() { return reinterpret_cast<unsigned char*>(this) + header_size(); }
+        unsigned char* end() { return reinterpret_cast<unsigned char*>(this) + m_size; }
+        size_t capacity() const { return m_size - header_size(); }
+
+        static constexpr size_t header_size() { return align_up(sizeof(Chunk), alignof(std::max_align_t)); }
+    };
+
+    struct DestructorNode {
+        void (*m_destroy)(void*);
+        void* m_object;
+        DestructorNode* m_prev;
+    };
+
+    static constexpr uintptr_t align_up(uintptr_t value, size_t alignment) { return (value + alignment - 1) & ~(static_cast<uintptr_t>(alignment) - 1); }
+
+    NEVER_INLINE void* allocate_slow(size_t size, size_t alignment)
+    {
+        VERIFY_WITH_MSG(size <= static_cast<size_t>(-1) / 2, "Arena cannot allocate %zu bytes", size);
+        size_t needed = size + alignment - 1;
+
+        // Chunks kept by `rewind()` and `reset()` come first, those too small for this allocation are skipped
+        Chunk* next = m_current ? m_current->m_next : m_first;
+        while (next && next->capacity() < needed)
+            next = next->m_next;
+
+        if (!next) {
+            next = allocate_chunk(needed + Chunk::header_size() > m_chunk_size ? needed + Chunk::header_size() : m_chunk_size);
+            if (m_current) {
+                next->m_next = m_current->m_next;
+                m_current->m_next = next;
+            } else {
+                next->m_next = m_first;
+                m_first = next;
+            }
+        }
+
+        m_current = next;
+        m_position = next->begin();
+        m_end = next->end();
+        return allocate(size, alignment);
+    }
+
+    Chunk* allocate_chunk(size_t size)
+    {
+        void* memory = nullptr;
+        bool mapped = false;
+
+#if TK_ARENA_HAS_MMAP
+        if (m_backing == ArenaBacking::Mmap) {
+            size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+            size = align_up(size, page_size);
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            VERIFY_WITH_MSG(memory != MAP_FAILED, "Arena failed to map a chunk of %zu bytes", size);
+            mapped = true;
+        }
+#endif
+
+        if (!mapped)
+            memory = ::operator new(size);
+
+        m_bytes_reserved += size;
+        return new (memory) Chunk { nullptr, size, mapped };
+    }
+
+    void release_chunks()
+    {
+        while (Chunk* chunk = m_first) {
+            m_first = chunk->m_next;
+#if TK_ARENA_HAS_MMAP
+            if (chunk->m_mapped) {
+                munmap(chunk, chunk->m_size);
+                continue;
+            }
+#endif
+            ::operator delete(chunk, chunk->m_size);
+        }
+        m_current = nullptr;
+        m_position = nullptr;
+        m_end = nullptr;
+        m_bytes_reserved = 0;
+    }
+
+    // Destroys objects in the reverse order of their construction, down to `until`
+    void run_destructors(DestructorNode* until)
+    {
+        while (m_destructors != until) {
+            DestructorNode* node = m_destructors;
+            m_destructors = node->m_prev;
+            node->m_destroy(node->m_object);
+        }
+    }
+
+private:
+    size_t m_chunk_size;
+    ArenaBacking m_backing;
+    Chunk* m_first { nullptr };
+    Chunk* m_current { nullptr };
+    unsigned char* m_position { nullptr };
+    unsigned char* m_end { nullptr };
+    DestructorNode* m_destructors { nullptr };
+    size_t m_bytes_reserved { 0 };
+};
+
+template<typename T>
+void ArenaDelete::operator()(T* ptr) const
+{
+    ptr->~T();
+    m_arena->deallocate(ptr, sizeof(T));
+}
+
+/* Arena Allocator Handle */
+// Plugs an `Arena` into containers taking an `Allocator`, e.g. `List<T, ArenaAllocator>` or `Vector<T, ..., ArenaAllocator>`
+// Containers still destroy their elements, the arena only takes care of the memory
+class ArenaAllocator {
+public:
+    ArenaAllocator(Arena& arena)
+        : m_arena(&arena)
+    {
+    }
+
+    ALWAYS_INLINE void* allocate(size_t size, size_t alignment) { return m_arena->allocate(size, alignment); }
+    ALWAYS_INLINE void deallocate(void* ptr, size_t size, size_t) { m_arena->deallocate(ptr, size); }
+
+    bool operator==(const ArenaAllocator& other) const { return m_arena == other.m_arena; }
+
+private:
+    Arena* m_arena;
+};
+
+}
+
+using TK::Arena;
+using TK::ArenaAllocator;
+using TK::ArenaBacking;
+using TK::ArenaDelete;
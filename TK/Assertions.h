@@ -21,7 +21,7 @@
         } \
     } while (0)
 
-#define VEIRFY(expr) \
+#define VERIFY(expr) \
     do { \
         if (!(expr)) { \
             crash("[Verify] " __FILE__ ":" __stringify(__LINE__) " " #expr "\n"); \
@@ -29,7 +29,7 @@
     } while (0)
 
 
-#define VEIRFY_WITH_MSG(expr, msg, ...) \
+#define VERIFY_WITH_MSG(expr, msg, ...) \
     do { \
         if (!(expr)) { \
             crash("[Verify] " __FILE__ ":" __stringify(__LINE__) " " #expr "\n" msg "\n", ##__VA_ARGS__); \
@@ -40,13 +40,4 @@ extern "C" {
 
 __attribute__((noreturn)) void crash(const char* msg, ...) __attribute__((format(printf, 1, 2)));
 
-void crash(const char* msg, ...)
-{
-    va_list args;
-    va_start(args, msg);
-    vfprintf(stdout, msg, args);
-    va_end(args);
-    exit(1);
-}
-
 }
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Assertions.h"
+#include "Definitions.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include <atomic>
+
+namespace TK {
+
+namespace Internal {
+
+// The thread-safe counterpart of `RefCountedBase`
+// Taking a reference only needs atomicity, since the caller already holds one keeping the object alive
+// Dropping one is acq_rel, so that every write made through other references happens before the object dies
+class AtomicRefCountedBase {
+    TK_MAKE_NONCOPYABLE(AtomicRefCountedBase)
+    TK_MAKE_NONMOVABLE(AtomicRefCountedBase)
+
+public:
+    ALWAYS_INLINE void ref() const { m_ref_cnt.fetch_add(1, std::memory_order_relaxed); }
+    ALWAYS_INLINE unsigned ref_count() const { return m_ref_cnt.load(std::memory_order_relaxed); }
+
+    // Takes a reference only if the count has not dropped to zero yet, the object is being destroyed otherwise
+    ALWAYS_INLINE bool try_ref() const
+    {
+        unsigned ref_cnt = m_ref_cnt.load(std::memory_order_relaxed);
+        do {
+            if (ref_cnt == 0)
+                return false;
+        } while (!m_ref_cnt.compare_exchange_weak(ref_cnt, ref_cnt + 1, std::memory_order_relaxed));
+        return true;
+    }
+
+protected:
+    AtomicRefCountedBase() = default;
+    ~AtomicRefCountedBase() = default;
+
+    // Returns whether the pointer should be freed or not
+    ALWAYS_INLINE bool deref_base() const
+    {
+        unsigned old_ref_cnt = m_ref_cnt.fetch_sub(1, std::memory_order_acq_rel);
+        ASSERT(old_ref_cnt > 0);
+        return old_ref_cnt == 1;
+    }
+
+private:
+    mutable std::atomic<unsigned> m_ref_cnt { 0 };
+};
+
+} // namespace Internal
+
+// Drop-in replacement for `RefCounted<T>` whose objects may be shared by `Ref`, `RefPtr` and `WeakPtr` across threads
+template<typename T>
+class AtomicRefCounted : public Internal::AtomicRefCountedBase {
+    TK_MAKE_NONCOPYABLE(AtomicRefCounted)
+
+public:
+    ALWAYS_INLINE void deref() const
+    {
+        if (!deref_base())
+            return;
+
+        T* object = const_cast<T*>(static_cast<const T*>(this));
+
+        // Objects made by `make_ref_with_weak` share their storage with their weak flag, which frees it
+        if constexpr (requires { object->destroy_if_fused(); }) {
+            if (object->destroy_if_fused())
+                return;
+        }
+
+        delete object;
+    }
+
+protected:
+    AtomicRefCounted()
+    {
+    }
+
+    ~AtomicRefCounted()
+    {
+    }
+};
+
+} // namespace TK
@@ -1,12 +1,13 @@
 #pragma once
 
-#include "List.h"
+#include "RingBuffer.h"
 #include "Utility.h"
 
 namespace TK {
 
-/* Linked Double-ended Queue */
-template<typename T, typename Container = List<T>>
+/* Double-ended Queue with a contiguous RingBuffer as its default underlying container */
+// `List<T>` can still be used as the container when references must stay valid across pushes
+template<typename T, typename Container = RingBuffer<T>>
 class Deque {
 public:
     using ValueType = T;
@@ -14,7 +15,7 @@ public:
     using ConstReference = const T&;
     using Pointer = T*;
     using ConstPointer = const T*;
-    using SizeType = unsigned;
+    using SizeType = typename Container::SizeType;
 
 public:
     Deque() = default;
@@ -30,8 +31,17 @@ public:
     {
     }
 
-    Deque& operator=(const Deque& other) { m_deque = other.m_deque; }
-    Deque& operator=(Deque&& other) noexcept { m_deque = TK::move(other.m_deque); }
+    Deque& operator=(const Deque& other)
+    {
+        m_deque = other.m_deque;
+        return *this;
+    }
+
+    Deque& operator=(Deque&& other) noexcept
+    {
+        m_deque = TK::move(other.m_deque);
+        return *this;
+    }
 
     T& front() noexcept { return m_deque.front(); }
     const T& front() const noexcept { return m_deque.front(); }
@@ -39,8 +49,17 @@ public:
     T& back() noexcept { return m_deque.back(); }
     const T& back() const noexcept { return m_deque.back(); }
 
+    // Random access is only available when the container provides it
+    T& operator[](SizeType index) noexcept requires(requires(Container& c) { c[index]; }) { return m_deque[index]; }
+    const T& operator[](SizeType index) const noexcept requires(requires(const Container& c) { c[index]; }) { return m_deque[index]; }
+
+    auto begin() noexcept { return m_deque.begin(); }
+    auto end() noexcept { return m_deque.end(); }
+    auto begin() const noexcept { return m_deque.begin(); }
+    auto end() const noexcept { return m_deque.end(); }
+
     [[nodiscard]] bool empty() const { return m_deque.empty(); }
-    unsigned size() const { return m_deque.size(); }
+    SizeType size() const { return m_deque.size(); }
 
     void clear() noexcept { m_deque.clear(); }
 
@@ -71,10 +90,19 @@ private:
     Container m_deque { };
 };
 
-// TODO: Implement us
 template<typename T>
 bool operator==(const Deque<T>& lhs, const Deque<T>& rhs)
 {
+    if (lhs.size() != rhs.size())
+        return false;
+
+    auto rhs_it = rhs.begin();
+    for (const T& element : lhs) {
+        if (!(element == *rhs_it))
+            return false;
+        ++rhs_it;
+    }
+    return true;
 }
 
 template<typename T>
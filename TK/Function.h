@@ -1,18 +1,23 @@
 #pragma once
 
 #include "Assertions.h"
+#include "Definitions.h"
 #include "NonCopyable.h"
 #include "NonMovable.h"
-#include "OwnPtr.h"
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <utility>
 
 namespace TK {
 
-template<typename T>
+// Callables which fit in `inline_capacity` bytes and are nothrow movable are stored inside the `Function` itself,
+// larger ones fall back to a heap allocation
+template<typename T, size_t inline_capacity = 4 * sizeof(void*)>
 class Function;
 
-template<typename ReturnType, typename... ArgTypes>
-class Function<ReturnType (ArgTypes...)> {
+template<typename ReturnType, typename... ArgTypes, size_t inline_capacity>
+class Function<ReturnType (ArgTypes...), inline_capacity> {
     TK_MAKE_NONCOPYABLE(Function)
 
 private:
@@ -20,16 +25,20 @@ private:
     public:
         virtual ~CallableWrapperBase() = default;
         virtual ReturnType invoke(ArgTypes... args) = 0;
+        // Move-construct this wrapper into the inline storage of another `Function`
+        virtual void move_into(void* storage) noexcept = 0;
     };
 
-    template<typename CallableType>
+    // Only wrappers living in the inline storage are ever moved through `move_into()`, heap ones change hands by pointer
+    template<typename CallableType, bool stored_inline>
     class CallableWrapper final : public CallableWrapperBase {
         TK_MAKE_NONCOPYABLE(CallableWrapper)
         TK_MAKE_NONMOVABLE(CallableWrapper)
 
     public:
-        explicit CallableWrapper(CallableType&& callable)
-            : m_callable(std::move(callable))
+        template<typename U>
+        explicit CallableWrapper(U&& callable)
+            : m_callable(std::forward<U>(callable))
         {
         }
 
@@ -37,13 +46,37 @@ private:
 
         ReturnType invoke(ArgTypes... args) override { return m_callable(std::forward<ArgTypes>(args)...); }
 
+        void move_into(void* storage) noexcept override
+        {
+            if constexpr (stored_inline) {
+                static_assert(std::is_nothrow_move_constructible<CallableType>::value, "Inline callables must be nothrow movable");
+                new (storage) CallableWrapper(std::move(m_callable));
+            } else {
+                VERIFY_WITH_MSG(false, "Heap allocated callables are never moved into inline storage");
+            }
+        }
+
     private:
         CallableType m_callable;
     };
 
+    // The vtable pointer of the wrapper lives in the inline storage as well
+    static constexpr size_t inline_storage_size = inline_capacity + sizeof(void*);
+
+    template<typename CallableType>
+    static constexpr bool fits_inline = sizeof(CallableWrapper<CallableType, false>) <= inline_storage_size
+        && alignof(CallableWrapper<CallableType, false>) <= alignof(std::max_align_t)
+        && std::is_nothrow_move_constructible<CallableType>::value;
+
+    enum class Kind : unsigned char {
+        Null,
+        Inline,
+        Outline,
+    };
+
 public:
     Function() = default;
-    ~Function() = default;
+    ~Function() { clear(); }
 
     Function(decltype(nullptr))
         : Function()
@@ -51,55 +84,122 @@ public:
     }
 
     template<typename CallableType>
-    Function(CallableType&& callable)
-        : m_callable_wrapper(make_own<CallableWrapper<CallableType>>(std::forward<CallableType>(callable)))
+    Function(CallableType&& callable) requires(!std::is_same<std::remove_cvref_t<CallableType>, Function>::value
+        && std::is_invocable_r<ReturnType, std::decay_t<CallableType>&, ArgTypes...>::value)
     {
+        init_with_callable(std::forward<CallableType>(callable));
     }
 
-    template<typename FunctionType>
-    Function(FunctionType func)
-        : m_callable_wrapper(make_own<CallableWrapper<FunctionType>>(std::forward<FunctionType>(func)))
+    Function(Function&& other) noexcept
     {
+        move_from(std::move(other));
     }
 
-    // Function(Function&& other)
-    // {
-    // }
-
     template<typename CallableType>
-    Function& opeartor=(CallableType&& callable)
+    Function& operator=(CallableType&& callable) requires(!std::is_same<std::remove_cvref_t<CallableType>, Function>::value
+        && std::is_invocable_r<ReturnType, std::decay_t<CallableType>&, ArgTypes...>::value)
     {
-        m_callable_wrapper = make_own<CallableWrapper<CallableType>>(std::forward<CallableType>(callable));
+        Function temp { std::forward<CallableType>(callable) };
+        clear();
+        move_from(std::move(temp));
         return *this;
     }
 
-    template<typename FunctionType>
-    Function& operator=(FunctionType func)
+    Function& operator=(decltype(nullptr))
     {
-        m_callable_wrapper = make_own<CallableWrapper<FunctionType>>(std::forward<FunctionType>(func));
+        clear();
         return *this;
     }
 
-    Function& operator=(decltype(nullptr))
+    Function& operator=(Function&& other) noexcept
     {
-        m_callable_wrapper = nullptr;
+        if (this != &other) {
+            clear();
+            move_from(std::move(other));
+        }
         return *this;
     }
 
-    // Function& operator=(Function&& other)
-    // {
-    // }
-
     ReturnType operator()(ArgTypes... args) const
     {
-        ASSERT(m_callable_wrapper);
-        return m_callable_wrapper->invoke(std::forward<ArgTypes>(args)...);
+        CallableWrapperBase* wrapper = callable_wrapper();
+        ASSERT(wrapper);
+        return wrapper->invoke(std::forward<ArgTypes>(args)...);
     }
 
-    explicit operator bool() const { return !!m_callable_wrapper; }
+    explicit operator bool() const { return m_kind != Kind::Null; }
+
+    // Whether the callable lives in the inline storage rather than on the heap
+    bool is_inline() const { return m_kind == Kind::Inline; }
 
 private:
-    OwnPtr<CallableWrapperBase> m_callable_wrapper { nullptr };
+    template<typename CallableType>
+    void init_with_callable(CallableType&& callable)
+    {
+        constexpr bool stored_inline = fits_inline<std::decay_t<CallableType>>;
+        using WrapperType = CallableWrapper<std::decay_t<CallableType>, stored_inline>;
+
+        if constexpr (stored_inline) {
+            new (m_storage) WrapperType(std::forward<CallableType>(callable));
+            m_kind = Kind::Inline;
+        } else {
+            m_outline_wrapper = new WrapperType(std::forward<CallableType>(callable));
+            m_kind = Kind::Outline;
+        }
+    }
+
+    ALWAYS_INLINE CallableWrapperBase* callable_wrapper() const
+    {
+        switch (m_kind) {
+        case Kind::Inline:
+            return std::launder(reinterpret_cast<CallableWrapperBase*>(const_cast<unsigned char*>(m_storage)));
+        case Kind::Outline:
+            return m_outline_wrapper;
+        default:
+            return nullptr;
+        }
+    }
+
+    void move_from(Function&& other) noexcept
+    {
+        switch (other.m_kind) {
+        case Kind::Inline:
+            other.callable_wrapper()->move_into(m_storage);
+            m_kind = Kind::Inline;
+            other.clear();
+            break;
+        case Kind::Outline:
+            m_outline_wrapper = std::exchange(other.m_outline_wrapper, nullptr);
+            m_kind = Kind::Outline;
+            other.m_kind = Kind::Null;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void clear()
+    {
+        switch (m_kind) {
+        case Kind::Inline:
+            callable_wrapper()->~CallableWrapperBase();
+            break;
+        case Kind::Outline:
+            delete m_outline_wrapper;
+            m_outline_wrapper = nullptr;
+            break;
+        default:
+            break;
+        }
+        m_kind = Kind::Null;
+    }
+
+private:
+    union {
+        alignas(std::max_align_t) unsigned char m_storage[inline_storage_size];
+        CallableWrapperBase* m_outline_wrapper;
+    };
+    Kind m_kind { Kind::Null };
 };
 
 }
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Definitions.h"
+#include <type_traits>
+#include <utility>
+
+namespace TK {
+
+// Non-Owning Reference to a Callable
+// Two words and trivially copyable, invoking it costs a single indirect call
+// The referenced callable must outlive the `FunctionRef`, so it is meant to be used as a function parameter
+
+template<typename T>
+class FunctionRef;
+
+template<typename ReturnType, typename... ArgTypes>
+class FunctionRef<ReturnType (ArgTypes...)> {
+public:
+    // A `FunctionRef` always refers to something callable
+    FunctionRef() = delete;
+    FunctionRef(decltype(nullptr)) = delete;
+
+    FunctionRef(const FunctionRef&) = default;
+    FunctionRef& operator=(const FunctionRef&) = default;
+    ~FunctionRef() = default;
+
+    ALWAYS_INLINE FunctionRef(ReturnType (*function)(ArgTypes...)) noexcept
+        : m_trampoline(&invoke_function)
+    {
+        m_storage.function = function;
+    }
+
+    template<typename CallableType>
+    ALWAYS_INLINE FunctionRef(CallableType&& callable) noexcept requires(!std::is_same<std::remove_cvref_t<CallableType>, FunctionRef>::value
+        && !std::is_function<std::remove_pointer_t<std::remove_cvref_t<CallableType>>>::value
+        && std::is_invocable_r<ReturnType, CallableType&, ArgTypes...>::value)
+        : m_trampoline(&invoke_callable<std::remove_reference_t<CallableType>>)
+    {
+        m_storage.object = const_cast<void*>(static_cast<const void*>(&callable));
+    }
+
+    ALWAYS_INLINE ReturnType operator()(ArgTypes... args) const
+    {
+        return m_trampoline(m_storage, std::forward<ArgTypes>(args)...);
+    }
+
+private:
+    union Storage {
+        void* object;
+        ReturnType (*function)(ArgTypes...);
+    };
+
+    static ReturnType invoke_function(Storage storage, ArgTypes... args)
+    {
+        return storage.function(std::forward<ArgTypes>(args)...);
+    }
+
+    template<typename CallableType>
+    static ReturnType invoke_callable(Storage storage, ArgTypes... args)
+    {
+        return (*static_cast<CallableType*>(storage.object))(std::forward<ArgTypes>(args)...);
+    }
+
+private:
+    Storage m_storage;
+    ReturnType (*m_trampoline)(Storage, ArgTypes...);
+};
+
+}
+
+using TK::FunctionRef;
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "Allocator.h"
+#include "HashTable.h"
+#include "Utility.h"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+
+namespace TK {
+
+template<typename K, typename V>
+struct HashMapEntry {
+    K key;
+    V value;
+};
+
+/* Open Addressing Hash Map */
+// Entries live inline in one flat table, so a lookup touches a group of control bytes and then the matching entry, nothing else
+// Keys must not be modified through an iterator, since that would leave the entry in the wrong place
+// With a transparent `Hash` and `KeyEqual` (the default for `std::string` keys), lookups take anything comparable to a key
+// Iterators and references are invalidated by any insertion that grows or sweeps the table, erasure only invalidates the erased entry
+template<typename K, typename V, typename Hash = TK::Hash<K>, typename KeyEqual = std::equal_to<>, typename Allocator = TK::DefaultAllocator>
+class HashMap {
+public:
+    using KeyType = K;
+    using ValueType = V;
+    using Entry = HashMapEntry<K, V>;
+
+private:
+    struct KeyOf {
+        static const K& get(const Entry& entry) { return entry.key; }
+    };
+
+    using Table = Internal::HashTable<Entry, K, KeyOf, Hash, KeyEqual, Allocator>;
+
+    static constexpr bool is_transparent = requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; };
+
+public:
+    using Iterator = typename Table::Iterator;
+    using ConstIterator = typename Table::ConstIterator;
+    using InsertResult = typename Table::InsertResult;
+
+public:
+    HashMap() = default;
+
+    explicit HashMap(const Allocator& allocator)
+        : m_table(allocator)
+    {
+    }
+
+    HashMap(std::initializer_list<Entry> entries)
+    {
+        reserve(entries.size());
+        for (const Entry& entry : entries)
+            insert(entry.key, entry.value);
+    }
+
+    [[nodiscard]] size_t size() const { return m_table.size(); }
+    [[nodiscard]] bool empty() const { return m_table.empty(); }
+    [[nodiscard]] size_t capacity() const { return m_table.capacity(); }
+    [[nodiscard]] float load_factor() const { return m_table.load_factor(); }
+    [[nodiscard]] float max_load_factor() const { return m_table.max_load_factor(); }
+
+    void set_max_load_factor(float factor) { m_table.set_max_load_factor(factor); }
+    void reserve(size_t count) { m_table.reserve(count); }
+    void clear() { m_table.clear(); }
+
+    Iterator begin() { return m_table.begin(); }
+    Iterator end() { return m_table.end(); }
+    ConstIterator begin() const { return m_table.begin(); }
+    ConstIterator end() const { return m_table.end(); }
+
+    Iterator find(const K& key) { return m_table.find(key); }
+    ConstIterator find(const K& key) const { return m_table.find(key); }
+    bool contains(const K& key) const { return m_table.contains(key); }
+
+    template<typename LookupKey>
+    Iterator find(const LookupKey& key) requires(is_transparent) { return m_table.find(key); }
+
+    template<typename LookupKey>
+    ConstIterator find(const LookupKey& key) const requires(is_transparent) { return m_table.find(key); }
+
+    template<typename LookupKey>
+    bool contains(const LookupKey& key) const requires(is_transparent) { return m_table.contains(key); }
+
+    // A pointer to the value of `key`, or `nullptr` if there is none
+    V* get(const K& key) { return get_impl(key); }
+    const V* get(const K& key) const { return const_cast<HashMap*>(this)->get_impl(key); }
+
+    template<typename LookupKey>
+    V* get(const LookupKey& key) requires(is_transparent) { return get_impl(key); }
+
+    template<typename LookupKey>
+    const V* get(const LookupKey& key) const requires(is_transparent) { return const_cast<HashMap*>(this)->get_impl(key); }
+
+    // Constructs the value from `args` only if `key` is not in the map yet
+    template<typename KeyArg, typename... Args>
+    InsertResult try_emplace(KeyArg&& key, Args&&... args)
+    {
+        return m_table.find_or_insert(lookup_key(key), [&](void* memory) {
+            new (memory) Entry { K(TK::forward<KeyArg>(key)), V(TK::forward<Args>(args)...) };
+        });
+    }
+
+    // Leaves the map untouched if `key` is already in it
+    template<typename KeyArg, typename ValueArg>
+    InsertResult insert(KeyArg&& key, ValueArg&& value)
+    {
+        return try_emplace(TK::forward<KeyArg>(key), TK::forward<ValueArg>(value));
+    }
+
+    template<typename KeyArg, typename ValueArg>
+    InsertResult insert_or_assign(KeyArg&& key, ValueArg&& value)
+    {
+        InsertResult result = try_emplace(TK::forward<KeyArg>(key), TK::forward<ValueArg>(value));
+        if (!result.inserted)
+            result.iterator->value = TK::forward<ValueArg>(value);
+        return result;
+    }
+
+    // Default constructs the value of a missing key
+    template<typename KeyArg>
+    V& operator[](KeyArg&& key) requires(std::is_default_constructible<V>::value)
+    {
+        return try_emplace(TK::forward<KeyArg>(key)).iterator->value;
+    }
+
+    bool erase(const K& key) { return m_table.erase_key(key); }
+
+    template<typename LookupKey>
+    bool erase(const LookupKey& key) requires(is_transparent) { return m_table.erase_key(key); }
+
+    void erase(Iterator it) { m_table.erase(it); }
+
+    void swap(HashMap& other) noexcept { m_table.swap(other.m_table); }
+
+private:
+    // Without a transparent hash, the table must only ever be probed with an actual `K`
+    template<typename KeyArg>
+    static decltype(auto) lookup_key(const KeyArg& key)
+    {
+        if constexpr (is_transparent || std::is_same<std::remove_cvref_t<KeyArg>, K>::value)
+            return (key);
+        else
+            return K(key);
+    }
+
+    template<typename LookupKey>
+    V* get_impl(const LookupKey& key)
+    {
+        Iterator it = m_table.find(key);
+        return it != m_table.end() ? &it->value : nullptr;
+    }
+
+private:
+    Table m_table;
+};
+
+}
+
+using TK::HashMap;
+using TK::HashMapEntry;
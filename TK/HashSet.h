@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Allocator.h"
+#include "HashTable.h"
+#include "Utility.h"
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+
+namespace TK {
+
+/* Open Addressing Hash Set */
+// The same flat table as `HashMap`, holding bare keys
+// Keys must not be modified through an iterator, since that would leave them in the wrong place
+// Iterators and references are invalidated by any insertion that grows or sweeps the table, erasure only invalidates the erased key
+template<typename K, typename Hash = TK::Hash<K>, typename KeyEqual = std::equal_to<>, typename Allocator = TK::DefaultAllocator>
+class HashSet {
+private:
+    struct KeyOf {
+        static const K& get(const K& key) { return key; }
+    };
+
+    using Table = Internal::HashTable<K, K, KeyOf, Hash, KeyEqual, Allocator>;
+
+    static constexpr bool is_transparent = requires { typename Hash::is_transparent; typename KeyEqual::is_transparent; };
+
+public:
+    using ValueType = K;
+    using Iterator = typename Table::ConstIterator;
+    using ConstIterator = typename Table::ConstIterator;
+    using InsertResult = Internal::HashTableInsertResult<Iterator>;
+
+public:
+    HashSet() = default;
+
+    explicit HashSet(const Allocator& allocator)
+        : m_table(allocator)
+    {
+    }
+
+    HashSet(std::initializer_list<K> keys)
+    {
+        reserve(keys.size());
+        for (const K& key : keys)
+            insert(key);
+    }
+
+    [[nodiscard]] size_t size() const { return m_table.size(); }
+    [[nodiscard]] bool empty() const { return m_table.empty(); }
+    [[nodiscard]] size_t capacity() const { return m_table.capacity(); }
+    [[nodiscard]] float load_factor() const { return m_table.load_factor(); }
+    [[nodiscard]] float max_load_factor() const { return m_table.max_load_factor(); }
+
+    void set_max_load_factor(float factor) { m_table.set_max_load_factor(factor); }
+    void reserve(size_t count) { m_table.reserve(count); }
+    void clear() { m_table.clear(); }
+
+    ConstIterator begin() const { return m_table.begin(); }
+    ConstIterator end() const { return m_table.end(); }
+
+    ConstIterator find(const K& key) const { return m_table.find(key); }
+    bool contains(const K& key) const { return m_table.contains(key); }
+
+    template<typename LookupKey>
+    ConstIterator find(const LookupKey& key) const requires(is_transparent) { return m_table.find(key); }
+
+    template<typename LookupKey>
+    bool contains(const LookupKey& key) const requires(is_transparent) { return m_table.contains(key); }
+
+    template<typename KeyArg>
+    InsertResult insert(KeyArg&& key)
+    {
+        auto result = m_table.find_or_insert(lookup_key(key), [&](void* memory) { new (memory) K(TK::forward<KeyArg>(key)); });
+        return { ConstIterator(result.iterator), result.inserted };
+    }
+
+    bool erase(const K& key) { return m_table.erase_key(key); }
+
+    template<typename LookupKey>
+    bool erase(const LookupKey& key) requires(is_transparent) { return m_table.erase_key(key); }
+
+    void erase(ConstIterator it) { m_table.erase(it); }
+
+    void swap(HashSet& other) noexcept { m_table.swap(other.m_table); }
+
+private:
+    // Without a transparent hash, the table must only ever be probed with an actual `K`
+    template<typename KeyArg>
+    static decltype(auto) lookup_key(const KeyArg& key)
+    {
+        if constexpr (is_transparent || std::is_same<std::remove_cvref_t<KeyArg>, K>::value)
+            return (key);
+        else
+            return K(key);
+    }
+
+private:
+    Table m_table;
+};
+
+}
+
+using TK::HashSet;
@@ -0,0 +1,633 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Assertions.h"
+#include "Definitions.h"
+#include "Utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if !defined(TK_HASH_TABLE_SSE2) && defined(__SSE2__)
+#define TK_HASH_TABLE_SSE2 1
+#endif
+
+#if !defined(TK_HASH_TABLE_SSE2)
+#define TK_HASH_TABLE_SSE2 0
+#endif
+
+#if TK_HASH_TABLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace TK {
+
+namespace Internal {
+
+// Spreads the entropy of a hash over all of its bits, the table takes its probe start from the high bits and its tag from the low ones
+ALWAYS_INLINE constexpr size_t mix_hash(size_t hash)
+{
+    uint64_t value = hash;
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    return static_cast<size_t>(value);
+}
+
+} // namespace Internal
+
+/* Default Hash */
+// `std::hash` of integers is the identity, so it goes through a mixing step before the table sees it
+template<typename T>
+struct Hash {
+    size_t operator()(const T& value) const { return Internal::mix_hash(std::hash<T> { }(value)); }
+};
+
+// Strings can be looked up by `std::string_view` or `const char*` without building a `std::string`
+template<>
+struct Hash<std::string> {
+    using is_transparent = void;
+
+    size_t operator()(std::string_view value) const { return Internal::mix_hash(std::hash<std::string_view> { }(value)); }
+};
+
+namespace Internal {
+
+/* Control Bytes */
+// Every slot of the table has a control byte, full slots keep the low 7 bits of their hash in it, so it is never negative
+// A probe compares the bytes of a whole group of slots at once, and only looks at the keys whose tag matches
+using ControlByte = int8_t;
+
+static constexpr ControlByte control_empty = -128;
+static constexpr ControlByte control_deleted = -2;
+
+ALWAYS_INLINE constexpr bool is_full(ControlByte control) { return control >= 0; }
+
+// Read by lookups in a table which has not allocated yet
+alignas(16) inline constexpr ControlByte empty_group[16] = {
+    control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty,
+    control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty, control_empty,
+};
+
+// The slots of a group selected by a match, one bit per slot spaced `1 << shift` bits apart
+template<typename MaskType, int width, int shift>
+class GroupBitMask {
+public:
+    explicit GroupBitMask(MaskType mask)
+        : m_mask(mask)
+    {
+    }
+
+    explicit operator bool() const { return m_mask != 0; }
+
+    int lowest() const { return __builtin_ctzll(m_mask) >> shift; }
+
+    // The number of slots before the first selected one, counting from either end of the group
+    int trailing_zeros() const { return m_mask ? __builtin_ctzll(m_mask) >> shift : width; }
+    int leading_zeros() const { return m_mask ? (__builtin_clzll(m_mask) - (64 - (width << shift))) >> shift : width; }
+
+    GroupBitMask& operator++()
+    {
+        m_mask &= m_mask - 1;
+        return *this;
+    }
+
+    int operator*() const { return lowest(); }
+    bool operator!=(const GroupBitMask& other) const { return m_mask != other.m_mask; }
+
+    GroupBitMask begin() const { return *this; }
+    GroupBitMask end() const { return GroupBitMask(0); }
+
+private:
+    MaskType m_mask;
+};
+
+#if TK_HASH_TABLE_SSE2
+
+// Sixteen control bytes compared in a handful of SSE2 instructions
+struct Group {
+    static constexpr size_t width = 16;
+    using BitMask = GroupBitMask<uint32_t, 16, 0>;
+
+    explicit Group(const ControlByte* control)
+        : m_control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(control)))
+    {
+    }
+
+    BitMask match(ControlByte tag) const { return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), m_control)))); }
+    BitMask match_empty() const { return match(control_empty); }
+
+    // Empty and deleted are the only control bytes below -1
+    BitMask match_empty_or_deleted() const { return BitMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_control)))); }
+
+    __m128i m_control;
+};
+
+#else
+
+// Eight control bytes compared with word-wide bit tricks, where SSE2 is not available
+struct Group {
+    static constexpr size_t width = 8;
+    using BitMask = GroupBitMask<uint64_t, 8, 3>;
+
+    static constexpr uint64_t lsbs = 0x0101010101010101ULL;
+    static constexpr uint64_t msbs = 0x8080808080808080ULL;
+
+    explicit Group(const ControlByte* control)
+    {
+        std::memcpy(&m_control, control, sizeof(m_control));
+    }
+
+    // May report a few false positives, which the key comparison that follows weeds out
+    BitMask match(ControlByte tag) const
+    {
+        uint64_t x = m_control ^ (lsbs * static_cast<uint8_t>(tag));
+        return BitMask((x - lsbs) & ~x & msbs);
+    }
+
+    BitMask match_empty() const { return BitMask(m_control & (~m_control << 6) & msbs); }
+    BitMask match_empty_or_deleted() const { return BitMask(m_control & (~m_control << 7) & msbs); }
+
+    uint64_t m_control;
+};
+
+#endif
+
+template<typename Iterator>
+struct HashTableInsertResult {
+    Iterator iterator;
+    bool inserted;
+};
+
+/* Open Addressing Hash Table */
+// The common core of `HashMap` and `HashSet`, laid out in one flat block: the control bytes followed by the slots
+// Probing visits whole groups in a triangular sequence, which covers every group of a power-of-two sized table
+// Erased slots become tombstones only when a probe may have walked past them, the next rehash sweeps them away
+template<typename Slot, typename Key, typename KeyOf, typename Hash, typename KeyEqual, typename Allocator>
+class HashTable {
+private:
+    /* Hash Table Iterator */
+    template<typename TableType, typename ElementType>
+    class HashTableIterator {
+        friend HashTable;
+
+        template<typename OtherTable, typename OtherElement>
+        friend class HashTableIterator;
+
+    public:
+        constexpr HashTableIterator() = default;
+
+        // Lets an `Iterator` turn into a `ConstIterator`
+        template<typename OtherTable, typename OtherElement>
+        HashTableIterator(const HashTableIterator<OtherTable, OtherElement>& other) requires(std::is_const<ElementType>::value)
+            : m_table(other.m_table)
+            , m_index(other.m_index)
+        {
+        }
+
+        bool operator==(const HashTableIterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const HashTableIterator& other) const { return m_index != other.m_index; }
+
+        ElementType& operator*() const { return m_table->m_slots[m_index]; }
+        ElementType* operator->() const { return &m_table->m_slots[m_index]; }
+
+        HashTableIterator& operator++()
+        {
+            m_index++;
+            skip_free_slots();
+            return *this;
+        }
+
+        HashTableIterator operator++(int)
+        {
+            HashTableIterator it = *this;
+            ++*this;
+            return it;
+        }
+
+    private:
+        HashTableIterator(TableType* table, size_t index)
+            : m_table(table)
+            , m_index(index)
+        {
+            skip_free_slots();
+        }
+
+        void skip_free_slots()
+        {
+            while (m_index < m_table->m_capacity && !is_full(m_table->m_control[m_index]))
+                m_index++;
+        }
+
+        TableType* m_table { nullptr };
+        size_t m_index { 0 };
+    };
+
+public:
+    using Iterator = HashTableIterator<HashTable, Slot>;
+    using ConstIterator = HashTableIterator<const HashTable, const Slot>;
+    using InsertResult = HashTableInsertResult<Iterator>;
+
+    static constexpr float default_max_load_factor = 0.875f;
+
+public:
+    HashTable() = default;
+
+    explicit HashTable(const Allocator& allocator)
+        : m_allocator(allocator)
+    {
+    }
+
+    HashTable(const HashTable& other)
+        : m_hash(other.m_hash)
+        , m_key_equal(other.m_key_equal)
+        , m_allocator(other.m_allocator)
+        , m_max_load_factor(other.m_max_load_factor)
+    {
+        reserve(other.m_size);
+        for (const Slot& slot : other)
+            insert_unique_unchecked(slot);
+    }
+
+    HashTable(HashTable&& other) noexcept
+        : m_hash(TK::move(other.m_hash))
+        , m_key_equal(TK::move(other.m_key_equal))
+        , m_allocator(TK::move(other.m_allocator))
+    {
+        steal_from(other);
+    }
+
+    ~HashTable()
+    {
+        destroy_slots();
+        release_storage();
+    }
+
+    HashTable& operator=(const HashTable& other)
+    {
+        if (this != &other) {
+            HashTable temp { other };
+            swap(temp);
+        }
+        return *this;
+    }
+
+    HashTable& operator=(HashTable&& other) noexcept
+    {
+        if (this != &other) {
+            destroy_slots();
+            release_storage();
+            m_hash = TK::move(other.m_hash);
+            m_key_equal = TK::move(other.m_key_equal);
+
+            // The storage of `other` must keep going back to the allocator it came from
+            TK::swap(m_allocator, other.m_allocator);
+            steal_from(other);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] size_t size() const { return m_size; }
+    [[nodiscard]] bool empty() const { return m_size == 0; }
+    [[nodiscard]] size_t capacity() const { return m_capacity; }
+    [[nodiscard]] float load_factor() const { return m_capacity ? static_cast<float>(m_size) / static_cast<float>(m_capacity) : 0.0f; }
+    [[nodiscard]] float max_load_factor() const { return m_max_load_factor; }
+
+    // Lower factors shorten the probe chains at the expense of memory, the table rehashes right away if it is over the new limit
+    void set_max_load_factor(float factor)
+    {
+        VERIFY_WITH_MSG(factor > 0.0f && factor <= 1.0f, "HashTable load factor must be in (0, 1]");
+        size_t deleted = max_load(m_capacity) - m_size - m_growth_left;
+        m_max_load_factor = factor;
+
+        size_t limit = max_load(m_capacity);
+        if (m_size + deleted >= limit)
+            resize(capacity_for(m_size + 1));
+        else
+            m_growth_left = limit - m_size - deleted;
+    }
+
+    Iterator begin() { return Iterator(this, 0); }
+    Iterator end() { return Iterator(this, m_capacity); }
+    ConstIterator begin() const { return ConstIterator(this, 0); }
+    ConstIterator end() const { return ConstIterator(this, m_capacity); }
+
+    // Makes room for `count` elements without any rehashing on the way
+    void reserve(size_t count)
+    {
+        size_t capacity = capacity_for(count);
+        if (capacity > m_capacity)
+            resize(capacity);
+    }
+
+    void clear()
+    {
+        destroy_slots();
+        if (m_capacity)
+            reset_control();
+        m_size = 0;
+        m_growth_left = max_load(m_capacity);
+    }
+
+    template<typename LookupKey>
+    Iterator find(const LookupKey& key)
+    {
+        return Iterator(this, find_index(key));
+    }
+
+    template<typename LookupKey>
+    ConstIterator find(const LookupKey& key) const
+    {
+        return ConstIterator(this, find_index(key));
+    }
+
+    template<typename LookupKey>
+    bool contains(const LookupKey& key) const { return find_index(key) != m_capacity; }
+
+    // Calls `construct(void*)` to build the slot in place only if `key` is not in the table yet
+    template<typename LookupKey, typename Construct>
+    InsertResult find_or_insert(const LookupKey& key, Construct&& construct)
+    {
+        size_t hash = m_hash(key);
+        if (size_t index = find_index(key, hash); index != m_capacity)
+            return { Iterator(this, index), false };
+
+        size_t index = prepare_insert(hash);
+        construct(static_cast<void*>(&m_slots[index]));
+        return { Iterator(this, index), true };
+    }
+
+    template<typename LookupKey>
+    bool erase_key(const LookupKey& key)
+    {
+        size_t index = find_index(key);
+        if (index == m_capacity)
+            return false;
+        erase_at(index);
+        return true;
+    }
+
+    void erase(ConstIterator it)
+    {
+        ASSERT(it.m_table == this && it.m_index < m_capacity && is_full(m_control[it.m_index]));
+        erase_at(it.m_index);
+    }
+
+    void swap(HashTable& other) noexcept
+    {
+        TK::swap(m_hash, other.m_hash);
+        TK::swap(m_key_equal, other.m_key_equal);
+        TK::swap(m_allocator, other.m_allocator);
+        TK::swap(m_control, other.m_control);
+        TK::swap(m_slots, other.m_slots);
+        TK::swap(m_capacity, other.m_capacity);
+        TK::swap(m_size, other.m_size);
+        TK::swap(m_growth_left, other.m_growth_left);
+        TK::swap(m_max_load_factor, other.m_max_load_factor);
+    }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+    static constexpr size_t block_alignment = alignof(Slot) > 16 ? alignof(Slot) : 16;
+
+    // Visits `offset`, `offset + width`, `offset + 3 * width`, `offset + 6 * width`... wrapping around the table
+    class ProbeSequence {
+    public:
+        ProbeSequence(size_t hash, size_t mask)
+            : m_mask(mask)
+            , m_offset(hash & mask)
+        {
+        }
+
+        size_t offset() const { return m_offset; }
+        size_t offset(int slot) const { return (m_offset + static_cast<size_t>(slot)) & m_mask; }
+
+        void next()
+        {
+            m_index += Group::width;
+            m_offset = (m_offset + m_index) & m_mask;
+        }
+
+    private:
+        size_t m_mask;
+        size_t m_offset;
+        size_t m_index { 0 };
+    };
+
+    static size_t probe_start(size_t hash) { return hash >> 7; }
+    static ControlByte tag_of(size_t hash) { return static_cast<ControlByte>(hash & 0x7f); }
+
+    size_t max_load(size_t capacity) const
+    {
+        if (capacity == 0)
+            return 0;
+
+        // At least one slot stays empty, so that every probe terminates
+        size_t limit = static_cast<size_t>(static_cast<float>(capacity) * m_max_load_factor);
+        return limit < capacity - 1 ? limit : capacity - 1;
+    }
+
+    size_t capacity_for(size_t count) const
+    {
+        if (count == 0)
+            return 0;
+
+        size_t capacity = Group::width;
+        while (max_load(capacity) < count) {
+            VERIFY_WITH_MSG(capacity <= static_cast<size_t>(-1) / 2 / sizeof(Slot), "HashTable capacity overflow");
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    template<typename LookupKey>
+    size_t find_index(const LookupKey& key) const { return find_index(key, m_hash(key)); }
+
+    // Returns `m_capacity` when the key is not in the table
+    template<typename LookupKey>
+    size_t find_index(const LookupKey& key, size_t hash) const
+    {
+        if (m_capacity == 0)
+            return 0;
+
+        ProbeSequence sequence(probe_start(hash), m_capacity - 1);
+        ControlByte tag = tag_of(hash);
+        while (true) {
+            Group group(m_control + sequence.offset());
+            for (int slot : group.match(tag)) {
+                size_t index = sequence.offset(slot);
+                if (m_key_equal(KeyOf::get(m_slots[index]), key)) [[likely]]
+                    return index;
+            }
+            if (group.match_empty())
+                return m_capacity;
+            sequence.next();
+        }
+    }
+
+    // The first empty or deleted slot along the probe sequence of `hash`
+    size_t find_free_slot(size_t hash) const
+    {
+        ProbeSequence sequence(probe_start(hash), m_capacity - 1);
+        while (true) {
+            auto free_slots = Group(m_control + sequence.offset()).match_empty_or_deleted();
+            if (free_slots)
+                return sequence.offset(free_slots.lowest());
+            sequence.next();
+        }
+    }
+
+    // Claims a slot for a key known to be missing, growing the table or sweeping its tombstones first if needed
+    size_t prepare_insert(size_t hash)
+    {
+        size_t index = m_capacity ? find_free_slot(hash) : npos;
+        if (index == npos || (m_growth_left == 0 && m_control[index] != control_deleted)) {
+            rehash_for_insert();
+            index = find_free_slot(hash);
+        }
+
+        if (m_control[index] == control_empty)
+            m_growth_left--;
+        set_control(index, tag_of(hash));
+        m_size++;
+        return index;
+    }
+
+    NEVER_INLINE void rehash_for_insert()
+    {
+        // Mostly tombstones, sweeping them at the same capacity is enough
+        if (m_capacity && m_size < max_load(m_capacity) / 2)
+            resize(m_capacity);
+        else
+            resize(m_capacity ? m_capacity * 2 : capacity_for(1));
+    }
+
+    void insert_unique_unchecked(const Slot& slot)
+    {
+        size_t index = prepare_insert(m_hash(KeyOf::get(slot)));
+        new (&m_slots[index]) Slot(slot);
+    }
+
+    void erase_at(size_t index)
+    {
+        m_slots[index].~Slot();
+        m_size--;
+
+        // If every window of a group covering this slot also covers an empty slot, no probe ever went past it while it was full
+        size_t index_before = (index - Group::width) & (m_capacity - 1);
+        auto empty_after = Group(m_control + index).match_empty();
+        auto empty_before = Group(m_control + index_before).match_empty();
+        bool was_never_full = empty_before && empty_after
+            && static_cast<size_t>(empty_after.trailing_zeros() + empty_before.leading_zeros()) < Group::width;
+
+        set_control(index, was_never_full ? control_empty : control_deleted);
+        if (was_never_full)
+            m_growth_left++;
+    }
+
+    // The first bytes are mirrored after the last slot, so that a group may be loaded at any offset without wrapping
+    void set_control(size_t index, ControlByte control)
+    {
+        m_control[index] = control;
+        if (index < Group::width)
+            m_control[m_capacity + index] = control;
+    }
+
+    static size_t control_bytes(size_t capacity) { return (capacity + Group::width + alignof(Slot) - 1) / alignof(Slot) * alignof(Slot); }
+    static size_t block_size(size_t capacity) { return control_bytes(capacity) + capacity * sizeof(Slot); }
+
+    void reset_control() { std::memset(m_control, control_empty, m_capacity + Group::width); }
+
+    NEVER_INLINE void resize(size_t new_capacity)
+    {
+        ControlByte* old_control = m_control;
+        Slot* old_slots = m_slots;
+        size_t old_capacity = m_capacity;
+
+        auto* block = static_cast<unsigned char*>(m_allocator.allocate(block_size(new_capacity), block_alignment));
+        m_control = reinterpret_cast<ControlByte*>(block);
+        m_slots = reinterpret_cast<Slot*>(block + control_bytes(new_capacity));
+        m_capacity = new_capacity;
+        reset_control();
+
+        for (size_t i = 0; i < old_capacity; i++) {
+            if (!is_full(old_control[i]))
+                continue;
+
+            size_t hash = m_hash(KeyOf::get(old_slots[i]));
+            size_t index = find_free_slot(hash);
+            set_control(index, tag_of(hash));
+
+            if constexpr (TK::is_trivially_relocatable<Slot>::value) {
+                std::memcpy(static_cast<void*>(&m_slots[index]), static_cast<const void*>(&old_slots[i]), sizeof(Slot));
+            } else {
+                new (&m_slots[index]) Slot(TK::move(old_slots[i]));
+                old_slots[i].~Slot();
+            }
+        }
+
+        m_growth_left = max_load(m_capacity) - m_size;
+        if (old_capacity)
+            m_allocator.deallocate(old_control, block_size(old_capacity), block_alignment);
+    }
+
+    void destroy_slots()
+    {
+        if constexpr (!std::is_trivially_destructible<Slot>::value) {
+            for (size_t i = 0; i < m_capacity; i++) {
+                if (is_full(m_control[i]))
+                    m_slots[i].~Slot();
+            }
+        }
+    }
+
+    void release_storage()
+    {
+        if (m_capacity)
+            m_allocator.deallocate(m_control, block_size(m_capacity), block_alignment);
+        m_control = const_cast<ControlByte*>(empty_group);
+        m_slots = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growth_left = 0;
+    }
+
+    // Takes over the storage of `other`, this table must have none of its own
+    void steal_from(HashTable& other)
+    {
+        m_control = other.m_control;
+        m_slots = other.m_slots;
+        m_capacity = other.m_capacity;
+        m_size = other.m_size;
+        m_growth_left = other.m_growth_left;
+        m_max_load_factor = other.m_max_load_factor;
+
+        other.m_control = const_cast<ControlByte*>(empty_group);
+        other.m_slots = nullptr;
+        other.m_capacity = 0;
+        other.m_size = 0;
+        other.m_growth_left = 0;
+    }
+
+private:
+    [[no_unique_address]] Hash m_hash { };
+    [[no_unique_address]] KeyEqual m_key_equal { };
+    [[no_unique_address]] Allocator m_allocator { };
+    ControlByte* m_control { const_cast<ControlByte*>(empty_group) };
+    Slot* m_slots { nullptr };
+    size_t m_capacity { 0 };
+    size_t m_size { 0 };
+    size_t m_growth_left { 0 };
+    float m_max_load_factor { default_max_load_factor };
+};
+
+} // namespace Internal
+
+}
+
+using TK::Hash;
@@ -0,0 +1,295 @@
+#pragma once
+
+#include "Assertions.h"
+#include "ListNodeBase.h"
+#include "NonCopyable.h"
+#include "Utility.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace TK {
+
+template<typename T, auto member>
+class IntrusiveList;
+
+/* Intrusive List Node */
+// Embedded in `T` and linked by `IntrusiveList<T, &T::member>` without any allocation
+// `Container` decides what a list holds while the object is linked:
+//     `T*`        nothing, the object must unlink itself before it dies (its destructor does so)
+//     `RefPtr<T>` a strong reference, keeping the object alive as long as it is on the list
+//     `OwnPtr<T>` the ownership, the object is destroyed once it is unlinked
+// An object with several nodes can be on several lists at once, and unlinking it from any of them is O(1)
+template<typename T, typename Container = T*>
+class IntrusiveListNode : private Internal::ListNodeBase {
+    TK_MAKE_NONCOPYABLE(IntrusiveListNode)
+
+    template<typename U, auto member>
+    friend class IntrusiveList;
+
+public:
+    using ContainerType = Container;
+
+    IntrusiveListNode() = default;
+
+    ~IntrusiveListNode()
+    {
+        if (is_linked())
+            unhook();
+    }
+
+    [[nodiscard]] bool is_linked() const { return m_next != nullptr; }
+
+    void unlink()
+    {
+        if (!is_linked())
+            return;
+
+        unhook();
+        m_prev = nullptr;
+        m_next = nullptr;
+
+        // Dropping the reference may destroy the object this node lives in, so it must come last
+        if constexpr (holds_reference) {
+            Container self { TK::move(m_self) };
+        }
+    }
+
+private:
+    static constexpr bool holds_reference = !std::is_pointer<Container>::value;
+
+    struct Empty { };
+
+    [[no_unique_address]] std::conditional_t<holds_reference, Container, Empty> m_self { };
+};
+
+/* Intrusive Doubly Linked List */
+template<typename T, auto member>
+class IntrusiveList {
+    TK_MAKE_NONCOPYABLE(IntrusiveList)
+
+    using ListNodeBase = Internal::ListNodeBase;
+    using NodeType = std::remove_reference_t<decltype(static_cast<T*>(nullptr)->*member)>;
+
+public:
+    using ValueType = T;
+    using ContainerType = typename NodeType::ContainerType;
+
+private:
+    // An `OwnPtr` cannot be conjured from a plain reference, such objects have to be handed over
+    static constexpr bool can_reference_object = !NodeType::holds_reference || std::is_constructible<ContainerType, T&>::value;
+
+public:
+    /* Intrusive List Iterator */
+    template<typename ElementType>
+    class IntrusiveListIterator {
+        friend IntrusiveList;
+
+    public:
+        constexpr IntrusiveListIterator() = default;
+
+        bool operator==(const IntrusiveListIterator& other) const { return m_node == other.m_node; }
+        bool operator!=(const IntrusiveListIterator& other) const { return m_node != other.m_node; }
+
+        ElementType& operator*() const { return *object_of(m_node); }
+        ElementType* operator->() const { return object_of(m_node); }
+
+        IntrusiveListIterator& operator++()
+        {
+            m_node = m_node->m_next;
+            return *this;
+        }
+
+        IntrusiveListIterator operator++(int)
+        {
+            IntrusiveListIterator it = *this;
+            m_node = m_node->m_next;
+            return it;
+        }
+
+        IntrusiveListIterator& operator--()
+        {
+            m_node = m_node->m_prev;
+            return *this;
+        }
+
+        IntrusiveListIterator operator--(int)
+        {
+            IntrusiveListIterator it = *this;
+            m_node = m_node->m_prev;
+            return it;
+        }
+
+    private:
+        explicit IntrusiveListIterator(ListNodeBase* node)
+            : m_node(node)
+        {
+        }
+
+        ListNodeBase* m_node { nullptr };
+    };
+
+    using Iterator = IntrusiveListIterator<T>;
+    using ConstIterator = IntrusiveListIterator<const T>;
+
+public:
+    IntrusiveList()
+    {
+        m_sentinel.m_prev = &m_sentinel;
+        m_sentinel.m_next = &m_sentinel;
+    }
+
+    IntrusiveList(IntrusiveList&& other) noexcept
+        : IntrusiveList()
+    {
+        take_nodes_from(other);
+    }
+
+    ~IntrusiveList()
+    {
+        clear();
+    }
+
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept
+    {
+        if (this != &other) {
+            clear();
+            take_nodes_from(other);
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool is_empty() const { return m_sentinel.m_next == &m_sentinel; }
+
+    // The list does not keep count, since its objects may be unlinked without it noticing
+    [[nodiscard]] size_t size_slow() const
+    {
+        size_t size = 0;
+        for (const ListNodeBase* node = m_sentinel.m_next; node != &m_sentinel; node = node->m_next)
+            size++;
+        return size;
+    }
+
+    [[nodiscard]] T* first() const { return is_empty() ? nullptr : object_of(m_sentinel.m_next); }
+    [[nodiscard]] T* last() const { return is_empty() ? nullptr : object_of(m_sentinel.m_prev); }
+
+    Iterator begin() { return Iterator(m_sentinel.m_next); }
+    Iterator end() { return Iterator(&m_sentinel); }
+
+    ConstIterator begin() const { return ConstIterator(m_sentinel.m_next); }
+    ConstIterator end() const { return ConstIterator(sentinel()); }
+
+    // Objects already on another list through the same node are moved over to this one, keeping their reference
+    void append(T& object) requires(can_reference_object) { link_before(sentinel(), object); }
+    void prepend(T& object) requires(can_reference_object) { link_before(m_sentinel.m_next, object); }
+    void insert_before(T& position, T& object) requires(can_reference_object) { link_before(&(position.*member), object); }
+
+    // Hands the reference over to the list, the object must not be linked through this node yet
+    void append(ContainerType&& object) requires(NodeType::holds_reference) { adopt_before(sentinel(), TK::move(object)); }
+    void prepend(ContainerType&& object) requires(NodeType::holds_reference) { adopt_before(m_sentinel.m_next, TK::move(object)); }
+
+    void remove(T& object)
+    {
+        (object.*member).unlink();
+    }
+
+    [[nodiscard]] bool contains(const T& object) const
+    {
+        for (const ListNodeBase* node = m_sentinel.m_next; node != &m_sentinel; node = node->m_next) {
+            if (node == &(object.*member))
+                return true;
+        }
+        return false;
+    }
+
+    // Unlinks the first object, handing back whatever the list held it with
+    ContainerType take_first()
+    {
+        ASSERT(!is_empty());
+        return take(*object_of(m_sentinel.m_next));
+    }
+
+    ContainerType take_last()
+    {
+        ASSERT(!is_empty());
+        return take(*object_of(m_sentinel.m_prev));
+    }
+
+    void clear()
+    {
+        while (!is_empty())
+            (object_of(m_sentinel.m_next)->*member).unlink();
+    }
+
+private:
+    ListNodeBase* sentinel() const { return const_cast<ListNodeBase*>(&m_sentinel); }
+
+    static NodeType& node_of(T& object) { return object.*member; }
+
+    // Recovers the object from its embedded node, the same trick as `offsetof` but for a pointer to member
+    static T* object_of(const ListNodeBase* node)
+    {
+        constexpr uintptr_t fake_address = alignof(T) * 64;
+        auto offset = reinterpret_cast<uintptr_t>(&(reinterpret_cast<T*>(fake_address)->*member)) - fake_address;
+        const auto* node_type = static_cast<const NodeType*>(node);
+        return const_cast<T*>(reinterpret_cast<const T*>(reinterpret_cast<const unsigned char*>(node_type) - offset));
+    }
+
+    void link_before(ListNodeBase* position, T& object)
+    {
+        NodeType& node = node_of(object);
+        if (&node == position)
+            return;
+
+        if (node.is_linked()) {
+            node.unhook();
+        } else if constexpr (NodeType::holds_reference) {
+            node.m_self = ContainerType(object);
+        }
+
+        node.hook_before(position);
+    }
+
+    void adopt_before(ListNodeBase* position, ContainerType&& object)
+    {
+        NodeType& node = node_of(*object);
+        ASSERT(!node.is_linked());
+        node.m_self = TK::move(object);
+        node.hook_before(position);
+    }
+
+    ContainerType take(T& object)
+    {
+        NodeType& node = node_of(object);
+        node.unhook();
+        node.m_prev = nullptr;
+        node.m_next = nullptr;
+
+        if constexpr (NodeType::holds_reference)
+            return TK::move(node.m_self);
+        else
+            return &object;
+    }
+
+    void take_nodes_from(IntrusiveList& other)
+    {
+        if (other.is_empty())
+            return;
+
+        m_sentinel.m_next = other.m_sentinel.m_next;
+        m_sentinel.m_next->m_prev = &m_sentinel;
+        m_sentinel.m_prev = other.m_sentinel.m_prev;
+        m_sentinel.m_prev->m_next = &m_sentinel;
+
+        other.m_sentinel.m_next = &other.m_sentinel;
+        other.m_sentinel.m_prev = &other.m_sentinel;
+    }
+
+private:
+    ListNodeBase m_sentinel;
+};
+
+}
+
+using TK::IntrusiveListNode;
+using TK::IntrusiveList;
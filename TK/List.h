@@ -1,72 +1,20 @@
 #pragma once
 
+#include "Allocator.h"
+#include "ListNodeBase.h"
 #include "Utility.h"
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 
 namespace TK {
 
 /* Doubly Linked List */
-template<typename T>
+// Nodes come from `Allocator`, pass a `SlabAllocator` to recycle them in contiguous slabs for lists which churn a lot
+template<typename T, typename Allocator = DefaultAllocator>
 class List {
 private:
-    /* List Node Base */
-    struct ListNodeBase {
-        ListNodeBase* m_prev { nullptr };
-        ListNodeBase* m_next { nullptr };
-
-        constexpr ListNodeBase() = default;
-
-        /// @brief Hook this node right before the given node.
-        /// @code
-        /// +------+      +----------+
-        /// |      |----->|          |
-        /// | this |      | position |
-        /// |      |<-----|          |
-        /// +------+      +----------+
-        /// @endcode
-        void hook_before(ListNodeBase* node) noexcept
-        {
-            m_prev = node->m_prev;
-            node->m_prev->m_next = this;
-
-            m_next = node;
-            node->m_prev = this;
-        }
-
-        /// @brief Hook this node right after the given node.
-        /// @code
-        /// +----------+      +------+
-        /// |          |----->|      |
-        /// | position |      | this |
-        /// |          |<-----|      |
-        /// +----------+      +------+
-        /// @endcode
-        void hook_after(ListNodeBase* node) noexcept
-        {
-            m_next = node->m_next;
-            node->m_next->m_prev = this;
-
-            m_prev = node;
-            node->m_next = this;
-        }
-
-        /// @brief Unhooks this node from the linked list.
-        /// @code
-        /// +------+      +------+      +------+
-        /// |      |----->|      |----->|      |
-        /// | prev |      | this |      | next |
-        /// |      |<-----|      |<-----|      |
-        /// +------+      +------+      +------+
-        /// @endcode
-        void unhook() noexcept
-        {
-            m_prev->m_next = m_next;
-            m_next->m_prev = m_prev;
-        }
-
-        ~ListNodeBase() = default;
-    };
+    using ListNodeBase = Internal::ListNodeBase;
 
     /* List Node */
     struct ListNode : public ListNodeBase {
@@ -77,10 +25,10 @@ private:
         {
         }
 
-        template<typename V>
-        ListNode(V&& value)
+        template<typename... Args>
+        ListNode(Args&&... args)
             : ListNodeBase()
-            , m_value (forward<V>(value))
+            , m_value (TK::forward<Args>(args)...)
         {
         }
 
@@ -204,6 +152,7 @@ public:
     };
 
 public:
+    using SizeType = size_t;
     using ValueType = T;
     using Reference = T&;
     using ConstReference = const T&;
@@ -217,14 +166,19 @@ public:
 public:
     List() { connect_head_and_tail(); }
 
+    explicit List(const Allocator& allocator)
+        : m_allocator (allocator)
+    {
+        connect_head_and_tail();
+    }
+
     ~List()
     {
         clear();
-        delete m_head;
-        delete m_tail;
     }
 
     List(const List& other)
+        : m_allocator (other.m_allocator)
     {
         connect_head_and_tail();
         for (const T& obj : other)
@@ -232,20 +186,10 @@ public:
     }
 
     List(List&& other) noexcept
+        : m_allocator (TK::move(other.m_allocator))
     {
         connect_head_and_tail();
-        if (!other.empty()) {
-            m_head->m_next = other.m_head->m_next;
-            other.m_head->m_next->m_prev = m_head;
-
-            m_tail->m_prev = other.m_tail->m_prev;
-            other.m_tail->m_prev->m_next = m_tail;
-
-            other.connect_head_and_tail();
-
-            m_size = other.m_size;
-            other.m_size = 0;
-        }
+        take_nodes_from(other);
     }
 
     List(std::initializer_list<T> init_list)
@@ -275,18 +219,9 @@ public:
 
         clear();
 
-        if (!other.empty()) {
-            m_head->m_next = other.m_head->m_next;
-            other.m_head->m_next->m_prev = m_head;
-
-            m_tail->m_prev = other.m_tail->m_prev;
-            other.m_tail->m_prev->m_next = m_tail;
-
-            other.connect_head_and_tail();
-
-            m_size = other.m_size;
-            other.m_size = 0;
-        }
+        // The nodes of `other` must keep going back to the allocator they came from
+        TK::swap(m_allocator, other.m_allocator);
+        take_nodes_from(other);
 
         return *this;
     }
@@ -296,53 +231,54 @@ public:
         clear();
         for (const T& obj : init_list)
             push_back(obj);
+        return *this;
     }
 
-    [[nodiscard]] bool empty() const noexcept { return m_head->m_next == m_tail; }
+    [[nodiscard]] bool empty() const noexcept { return m_sentinel.m_next == &m_sentinel; }
 
-    [[nodiscard]] unsigned size() const noexcept { return m_size; }
+    [[nodiscard]] SizeType size() const noexcept { return m_size; }
 
-    [[nodiscard]] T& front() { return static_cast<ListNode*>(m_head->m_next)->m_value; }
-    [[nodiscard]] const T& front() const { return static_cast<ListNode*>(m_head->m_next)->m_value; }
+    [[nodiscard]] T& front() { return static_cast<ListNode*>(m_sentinel.m_next)->m_value; }
+    [[nodiscard]] const T& front() const { return static_cast<ListNode*>(m_sentinel.m_next)->m_value; }
 
-    [[nodiscard]] T& back() { return static_cast<ListNode*>(m_tail->m_prev)->m_value; }
-    [[nodiscard]] const T& back() const { return static_cast<ListNode*>(m_tail->m_prev)->m_value; }
+    [[nodiscard]] T& back() { return static_cast<ListNode*>(m_sentinel.m_prev)->m_value; }
+    [[nodiscard]] const T& back() const { return static_cast<ListNode*>(m_sentinel.m_prev)->m_value; }
 
-    Iterator begin() noexcept { return Iterator(m_head->m_next); }
-    Iterator end() noexcept { return Iterator(m_tail); }
+    Iterator begin() noexcept { return Iterator(m_sentinel.m_next); }
+    Iterator end() noexcept { return Iterator(sentinel()); }
 
-    ConstIterator begin() const noexcept { return Iterator(m_head->m_next); }
-    ConstIterator end() const noexcept { return Iterator(m_tail); }
+    ConstIterator begin() const noexcept { return Iterator(m_sentinel.m_next); }
+    ConstIterator end() const noexcept { return Iterator(sentinel()); }
 
-    ConstIterator cbegin() const noexcept { return Iterator(m_head->next); }
-    ConstIterator cend() const noexcept { return Iterator(m_tail); }
+    ConstIterator cbegin() const noexcept { return Iterator(m_sentinel.m_next); }
+    ConstIterator cend() const noexcept { return Iterator(sentinel()); }
 
-    ReverseIterator rbegin() noexcept { return ReverseIterator(m_tail->m_prev); }
-    ReverseIterator rend() noexcept { return ReverseIterator(m_head); }
+    ReverseIterator rbegin() noexcept { return ReverseIterator(m_sentinel.m_prev); }
+    ReverseIterator rend() noexcept { return ReverseIterator(sentinel()); }
 
-    ConstReverseIterator rbegin() const noexcept { return ReverseIterator(m_tail->m_prev); }
-    ConstReverseIterator rend() const noexcept { return ReverseIterator(m_head); }
+    ConstReverseIterator rbegin() const noexcept { return ReverseIterator(m_sentinel.m_prev); }
+    ConstReverseIterator rend() const noexcept { return ReverseIterator(sentinel()); }
 
-    ConstReverseIterator crbegin() const noexcept { return ReverseIterator(m_tail->m_prev); }
-    ConstReverseIterator crend() const noexcept { return ReverseIterator(m_head); }
+    ConstReverseIterator crbegin() const noexcept { return ReverseIterator(m_sentinel.m_prev); }
+    ConstReverseIterator crend() const noexcept { return ReverseIterator(sentinel()); }
 
     template<typename... Args>
     void emplace_back(Args&&... args)
     {
-        ListNode* node = new ListNode(forward<Args>(args)...);
-        node->hook_before(m_tail);
+        ListNode* node = create_node(TK::forward<Args>(args)...);
+        node->hook_before(sentinel());
         m_size++;
     }
 
     void push_back(const T& value) { emplace_back(value); }
-    void push_back(T&& value) { emplace_back(move(value)); }
+    void push_back(T&& value) { emplace_back(TK::move(value)); }
 
     void pop_back()
     {
-        if (m_tail->m_prev != m_head) {
-            ListNode* node = static_cast<ListNode*>(m_tail->m_prev);
+        if (!empty()) {
+            ListNode* node = static_cast<ListNode*>(m_sentinel.m_prev);
             node->unhook();
-            delete node;
+            destroy_node(node);
             m_size--;
         }
     }
@@ -350,49 +286,46 @@ public:
     template<typename... Args>
     void emplace_front(Args&&... args)
     {
-        ListNode* node = new ListNode(forward<Args>(args)...);
-        node->hook_after(m_head);
+        ListNode* node = create_node(TK::forward<Args>(args)...);
+        node->hook_after(sentinel());
         m_size++;
     }
 
     void push_front(const T& value) { emplace_front(value); }
-    void push_front(T&& value) { emplace_front(move(value)); }
+    void push_front(T&& value) { emplace_front(TK::move(value)); }
 
     void pop_front()
     {
-        if (m_head->m_next != m_tail) {
-            ListNode* node = static_cast<ListNode*>(m_head->m_next);
+        if (!empty()) {
+            ListNode* node = static_cast<ListNode*>(m_sentinel.m_next);
             node->unhook();
-            delete node;
+            destroy_node(node);
             m_size--;
         }
     }
 
     void clear()
     {
-        if (m_head && m_tail && m_head->m_next != m_tail) {
-            ListNode* node = static_cast<ListNode*>(m_head->m_next);
-            while (node != m_tail) {
-                ListNode* curr = node;
-                node = static_cast<ListNode*>(node->m_next);
-                delete curr;
-            }
-            m_head->m_next = m_tail;
-            m_tail->m_prev = m_head;
-            m_size = 0;
+        ListNodeBase* node = m_sentinel.m_next;
+        while (node != &m_sentinel) {
+            ListNodeBase* next = node->m_next;
+            destroy_node(static_cast<ListNode*>(node));
+            node = next;
         }
+        connect_head_and_tail();
+        m_size = 0;
     }
 
     template<typename... Args>
     void emplace(ConstIterator pos, Args&&... args)
     {
-        ListNode* node = new ListNode(forward<Args>(args)...);
+        ListNode* node = create_node(TK::forward<Args>(args)...);
         node->hook_before(pos.m_node);
         m_size++;
     }
 
     void insert(ConstIterator pos, const T& value) { emplace(pos, value); }
-    void insert(ConstIterator pos, T&& value) { emplace(pos, move(value)); }
+    void insert(ConstIterator pos, T&& value) { emplace(pos, TK::move(value)); }
 
     /// @brief Remove the element at `pos`
     Iterator erase(ConstIterator pos)
@@ -403,7 +336,8 @@ public:
         Iterator it = Iterator(pos.m_node->m_next);
         ListNode* node = static_cast<ListNode*>(pos.m_node);
         node->unhook();
-        delete node;
+        destroy_node(node);
+        m_size--;
 
         return it;
     }
@@ -411,11 +345,8 @@ public:
     /// @brief Remove the elements in the range `[first, last)`
     Iterator erase(ConstIterator first, ConstIterator last)
     {
-        if (first == last)
-            return last;
-
-        auto it = first;
-        for (auto it = first; it != last; )
+        Iterator it = Iterator(first.m_node);
+        while (it != last)
             it = erase(it);
 
         return it;
@@ -423,33 +354,110 @@ public:
 
     void swap(List& other) noexcept
     {
-        swap(m_head, other.m_head);
-        swap(m_tail, other.m_tail);
-        swap(m_size, other.m_size);
+        List temp { TK::move(other) };
+        other = TK::move(*this);
+        *this = TK::move(temp);
     }
 
-    // TODO: Implement us TnT
     /// @brief Merge two sorted lists into one, the lists should be be sorted into ascending order
-    void merge(List& other)
-    {
-    }
+    /// Nodes of `other` are relinked in linear time, and equal elements of this list stay in front of those of `other`
+    void merge(List& other) { merge(other, [](const T& lhs, const T& rhs) { return lhs < rhs; }); }
+    void merge(List&& other) { merge(other); }
 
-    void merge(List&& other)
+    template<typename Compare>
+    void merge(List& other, Compare comp)
     {
+        if (this == &other)
+            return;
+
+        Iterator mine = begin();
+        Iterator theirs = other.begin();
+        while (theirs != other.end()) {
+            if (mine == end()) {
+                splice(end(), other, theirs, other.end());
+                return;
+            }
+
+            if (!comp(*theirs, *mine)) {
+                ++mine;
+                continue;
+            }
+
+            // Splice the whole run of `other` which goes before `mine` at once
+            Iterator run_end = theirs;
+            do {
+                ++run_end;
+            } while (run_end != other.end() && comp(*run_end, *mine));
+
+            splice(mine, other, theirs, run_end);
+            theirs = run_end;
+        }
     }
 
     template<typename Compare>
-    void merge(List& other, Compare comp)
+    void merge(List&& other, Compare comp) { merge(other, comp); }
+
+    /// @brief Move all elements of `other` right before `pos`
+    /// Nodes are relinked when both lists can free each other's nodes, otherwise the values are moved across
+    void splice(ConstIterator pos, List& other)
     {
+        if (this == &other || other.empty())
+            return;
+
+        if (!(m_allocator == other.m_allocator)) {
+            splice(pos, other, other.begin(), other.end());
+            return;
+        }
+
+        relink(pos.m_node, other.m_sentinel.m_next, other.sentinel());
+        m_size += other.m_size;
+        other.m_size = 0;
     }
 
-    template<typename Compare>
-    void merge(List&& other, Compare comp)
+    void splice(ConstIterator pos, List&& other) { splice(pos, other); }
+
+    /// @brief Move the element at `it` of `other` right before `pos`
+    void splice(ConstIterator pos, List& other, ConstIterator it) { splice(pos, other, it, Iterator(it.m_node->m_next)); }
+    void splice(ConstIterator pos, List&& other, ConstIterator it) { splice(pos, other, it); }
+
+    /// @brief Move the elements in the range `[first, last)` of `other` right before `pos`, which must not be in the range
+    void splice(ConstIterator pos, List& other, ConstIterator first, ConstIterator last)
     {
+        if (first == last)
+            return;
+
+        if (this == &other) {
+            relink(pos.m_node, first.m_node, last.m_node);
+            return;
+        }
+
+        if (!(m_allocator == other.m_allocator)) {
+            for (Iterator it = Iterator(first.m_node); it != last; ) {
+                emplace(pos, TK::move(*it));
+                it = other.erase(it);
+            }
+            return;
+        }
+
+        SizeType count = 0;
+        for (const ListNodeBase* node = first.m_node; node != last.m_node; node = node->m_next)
+            count++;
+
+        relink(pos.m_node, first.m_node, last.m_node);
+        m_size += count;
+        other.m_size -= count;
     }
 
+    void splice(ConstIterator pos, List&& other, ConstIterator first, ConstIterator last) { splice(pos, other, first, last); }
+
+    /// @brief Reverse the order of the elements by swapping the links of every node, sentinel included
     void reverse() noexcept
     {
+        ListNodeBase* node = &m_sentinel;
+        do {
+            TK::swap(node->m_prev, node->m_next);
+            node = node->m_prev;
+        } while (node != &m_sentinel);
     }
 
     void remove(const T& value)
@@ -473,31 +481,145 @@ public:
         }
     }
 
-    // TODO: Implement insertion sort and merge sort
-    void sort()
-    {
-    }
+    /// @brief Sort the elements into ascending order
+    void sort() { sort([](const T& lhs, const T& rhs) { return lhs < rhs; }); }
 
+    /// @brief Stable bottom-up merge sort, which relinks the nodes and never allocates nor moves any value
+    /// While sorting, nodes are chained through `m_next` alone, and `buckets[i]` holds a sorted chain of 2^i nodes
     template<typename Compare>
     void sort(Compare comp)
     {
+        if (m_size < 2)
+            return;
+
+        constexpr size_t max_buckets = 64;
+        ListNodeBase* buckets[max_buckets] { };
+        size_t used_buckets = 0;
+
+        m_sentinel.m_prev->m_next = nullptr;
+        ListNodeBase* node = m_sentinel.m_next;
+        while (node) {
+            ListNodeBase* next = node->m_next;
+            node->m_next = nullptr;
+
+            // Carry the new node up like a binary counter, older chains are always the left operand to keep it stable
+            ListNodeBase* chain = node;
+            size_t i = 0;
+            for (; i < used_buckets && buckets[i]; i++) {
+                chain = merge_chains(buckets[i], chain, comp);
+                buckets[i] = nullptr;
+            }
+            if (i == used_buckets)
+                used_buckets++;
+            buckets[i] = chain;
+
+            node = next;
+        }
+
+        ListNodeBase* sorted = nullptr;
+        for (size_t i = 0; i < used_buckets; i++) {
+            if (buckets[i])
+                sorted = sorted ? merge_chains(buckets[i], sorted, comp) : buckets[i];
+        }
+
+        // Restore the backward links and close the circle again
+        ListNodeBase* prev = &m_sentinel;
+        for (node = sorted; node; node = node->m_next) {
+            prev->m_next = node;
+            node->m_prev = prev;
+            prev = node;
+        }
+        prev->m_next = &m_sentinel;
+        m_sentinel.m_prev = prev;
     }
 
 private:
+    // The head and the tail of the list share one sentinel node embedded in the list itself
+    ListNodeBase* sentinel() const noexcept { return const_cast<ListNodeBase*>(&m_sentinel); }
+
     void connect_head_and_tail()
     {
-        m_head->m_next = m_tail;
-        m_tail->m_prev = m_head;
+        m_sentinel.m_next = &m_sentinel;
+        m_sentinel.m_prev = &m_sentinel;
+    }
+
+    static T& value_of(ListNodeBase* node) noexcept { return static_cast<ListNode*>(node)->m_value; }
+
+    // Moves the nodes in `[first, last)` right before `position`, the nodes may belong to another list
+    static void relink(ListNodeBase* position, ListNodeBase* first, ListNodeBase* last) noexcept
+    {
+        if (position == first || position == last)
+            return;
+
+        ListNodeBase* tail = last->m_prev;
+        first->m_prev->m_next = last;
+        last->m_prev = first->m_prev;
+
+        first->m_prev = position->m_prev;
+        position->m_prev->m_next = first;
+        tail->m_next = position;
+        position->m_prev = tail;
+    }
+
+    // Merges two sorted null-terminated chains linked through `m_next`, taking from `lhs` on ties
+    template<typename Compare>
+    static ListNodeBase* merge_chains(ListNodeBase* lhs, ListNodeBase* rhs, Compare& comp)
+    {
+        ListNodeBase head;
+        ListNodeBase* tail = &head;
+        while (lhs && rhs) {
+            if (comp(value_of(rhs), value_of(lhs))) {
+                tail->m_next = rhs;
+                rhs = rhs->m_next;
+            } else {
+                tail->m_next = lhs;
+                lhs = lhs->m_next;
+            }
+            tail = tail->m_next;
+        }
+        tail->m_next = lhs ? lhs : rhs;
+        return head.m_next;
+    }
+
+    template<typename... Args>
+    ListNode* create_node(Args&&... args)
+    {
+        void* memory = m_allocator.allocate(sizeof(ListNode), alignof(ListNode));
+        return new (memory) ListNode(TK::forward<Args>(args)...);
+    }
+
+    void destroy_node(ListNode* node)
+    {
+        node->~ListNode();
+        m_allocator.deallocate(node, sizeof(ListNode), alignof(ListNode));
+    }
+
+    // Relinks all nodes of `other` into this list, which must be empty
+    void take_nodes_from(List& other) noexcept
+    {
+        if (other.empty())
+            return;
+
+        m_sentinel.m_next = other.m_sentinel.m_next;
+        m_sentinel.m_next->m_prev = &m_sentinel;
+
+        m_sentinel.m_prev = other.m_sentinel.m_prev;
+        m_sentinel.m_prev->m_next = &m_sentinel;
+
+        other.connect_head_and_tail();
+
+        m_size = other.m_size;
+        other.m_size = 0;
     }
 
 private:
-    ListNodeBase* m_head { new ListNodeBase };
-    ListNodeBase* m_tail { new ListNodeBase };
-    unsigned m_size { 0 };
+    [[no_unique_address]] Allocator m_allocator { };
+    ListNodeBase m_sentinel { };
+    SizeType m_size { 0 };
 };
 
-template<typename T>
-bool operator==(const List<T>& lhs, const List<T>& rhs)
+template<typename T, typename Allocator>
+bool operator==(const List<T, Allocator>& lhs, const List<T, Allocator>& rhs)
 {
     if (lhs.size() != rhs.size())
         return false;
@@ -0,0 +1,68 @@
+#pragma once
+
+namespace TK {
+
+namespace Internal {
+
+/* List Node Base */
+// Shared by the nodes of `List` and `IntrusiveList`, a node which is not linked has null pointers
+struct ListNodeBase {
+    ListNodeBase* m_prev { nullptr };
+    ListNodeBase* m_next { nullptr };
+
+    constexpr ListNodeBase() = default;
+
+    /// @brief Hook this node right before the given node.
+    /// @code
+    /// +------+      +----------+
+    /// |      |----->|          |
+    /// | this |      | position |
+    /// |      |<-----|          |
+    /// +------+      +----------+
+    /// @endcode
+    void hook_before(ListNodeBase* node) noexcept
+    {
+        m_prev = node->m_prev;
+        node->m_prev->m_next = this;
+
+        m_next = node;
+        node->m_prev = this;
+    }
+
+    /// @brief Hook this node right after the given node.
+    /// @code
+    /// +----------+      +------+
+    /// |          |----->|      |
+    /// | position |      | this |
+    /// |          |<-----|      |
+    /// +----------+      +------+
+    /// @endcode
+    void hook_after(ListNodeBase* node) noexcept
+    {
+        m_next = node->m_next;
+        node->m_next->m_prev = this;
+
+        m_prev = node;
+        node->m_next = this;
+    }
+
+    /// @brief Unhooks this node from the linked list.
+    /// @code
+    /// +------+      +------+      +------+
+    /// |      |----->|      |----->|      |
+    /// | prev |      | this |      | next |
+    /// |      |<-----|      |<-----|      |
+    /// +------+      +------+      +------+
+    /// @endcode
+    void unhook() noexcept
+    {
+        m_prev->m_next = m_next;
+        m_next->m_prev = m_prev;
+    }
+
+    ~ListNodeBase() = default;
+};
+
+} // namespace Internal
+
+} // namespace TK
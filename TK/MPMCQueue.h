@@ -0,0 +1,192 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Definitions.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "Utility.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace TK {
+
+/* Multi Producer Multi Consumer Queue */
+// A bounded array queue after Dmitry Vyukov's design, any number of threads may push and pop concurrently
+// Every slot carries a sequence number telling whose turn it is: the producer of position `p` waits for `p`,
+// the consumer of position `p` waits for `p + 1`, and the consumer hands the slot to the next lap with `p + capacity`
+// Slots sit on cache lines of their own, so neighbouring producers and consumers do not false share
+// `try_` variants give up when the queue is full or empty, the others take a ticket and sleep on their slot until its turn comes
+template<typename T, size_t capacity>
+class MPMCQueue {
+    TK_MAKE_NONCOPYABLE(MPMCQueue)
+    TK_MAKE_NONMOVABLE(MPMCQueue)
+
+    static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "MPMCQueue capacity must be a power of two");
+
+public:
+    using SizeType = size_t;
+    using ValueType = T;
+
+public:
+    MPMCQueue()
+        : m_slots(static_cast<Slot*>(DefaultAllocator().allocate(capacity * sizeof(Slot), alignof(Slot))))
+    {
+        for (size_t i = 0; i < capacity; i++)
+            new (&m_slots[i]) Slot(i);
+    }
+
+    // No thread may still be pushing or popping
+    ~MPMCQueue()
+    {
+        size_t tail = m_tail.load(std::memory_order_acquire);
+        for (size_t head = m_head.load(std::memory_order_relaxed); head != tail; head++) {
+            Slot& slot = slot_of(head);
+            if constexpr (!std::is_trivially_destructible<T>::value) {
+                if (slot.m_sequence.load(std::memory_order_acquire) == head + 1)
+                    slot.element().~T();
+            }
+        }
+        for (size_t i = 0; i < capacity; i++)
+            m_slots[i].~Slot();
+        DefaultAllocator().deallocate(m_slots, capacity * sizeof(Slot), alignof(Slot));
+    }
+
+    static constexpr SizeType max_size() { return capacity; }
+
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(TK::move(value)); }
+
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        size_t position = m_tail.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slot_of(position);
+            auto lag = static_cast<intptr_t>(slot.m_sequence.load(std::memory_order_acquire) - position);
+            if (lag == 0) {
+                if (m_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (lag < 0) {
+                // The slot still holds the element from the previous lap
+                return false;
+            } else {
+                position = m_tail.load(std::memory_order_relaxed);
+            }
+        }
+
+        publish(slot_of(position), position + 1, TK::forward<Args>(args)...);
+        return true;
+    }
+
+    void push(const T& value) { emplace(value); }
+    void push(T&& value) { emplace(TK::move(value)); }
+
+    // Blocks while the queue is full
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+        size_t position = m_tail.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slot_of(position);
+        wait_for_turn(slot, position);
+        publish(slot, position + 1, TK::forward<Args>(args)...);
+    }
+
+    bool try_pop(T& out)
+    {
+        size_t position = m_head.load(std::memory_order_relaxed);
+        while (true) {
+            Slot& slot = slot_of(position);
+            auto lag = static_cast<intptr_t>(slot.m_sequence.load(std::memory_order_acquire) - (position + 1));
+            if (lag == 0) {
+                if (m_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (lag < 0) {
+                // Nothing was published at this position yet
+                return false;
+            } else {
+                position = m_head.load(std::memory_order_relaxed);
+            }
+        }
+
+        out = consume(slot_of(position), position);
+        return true;
+    }
+
+    // Blocks while the queue is empty
+    T pop()
+    {
+        size_t position = m_head.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slot_of(position);
+        wait_for_turn(slot, position + 1);
+        return consume(slot, position);
+    }
+
+    // Only a snapshot, other threads may change it right away, and blocked threads count as pending elements
+    [[nodiscard]] SizeType size_approx() const
+    {
+        auto size = static_cast<intptr_t>(m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_relaxed));
+        return size > 0 ? static_cast<size_t>(size) : 0;
+    }
+
+    [[nodiscard]] bool empty_approx() const { return size_approx() == 0; }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+    static constexpr size_t mask = capacity - 1;
+
+    struct alignas(alignof(T) > cache_line_size ? alignof(T) : cache_line_size) Slot {
+        // The storage stays uninitialized until an element is published into it
+        explicit Slot(size_t sequence)
+            : m_sequence(sequence)
+        {
+        }
+
+        std::atomic<size_t> m_sequence;
+        alignas(T) unsigned char m_storage[sizeof(T)];
+
+        T& element() { return *std::launder(reinterpret_cast<T*>(m_storage)); }
+    };
+
+    ALWAYS_INLINE Slot& slot_of(size_t position) { return m_slots[position & mask]; }
+
+    // Sleeps on the sequence number of the slot, whoever moves it along wakes its waiters
+    ALWAYS_INLINE static void wait_for_turn(Slot& slot, size_t sequence)
+    {
+        while (true) {
+            size_t current = slot.m_sequence.load(std::memory_order_acquire);
+            if (current == sequence)
+                return;
+            slot.m_sequence.wait(current, std::memory_order_acquire);
+        }
+    }
+
+    template<typename... Args>
+    ALWAYS_INLINE static void publish(Slot& slot, size_t sequence, Args&&... args)
+    {
+        new (slot.m_storage) T(TK::forward<Args>(args)...);
+        slot.m_sequence.store(sequence, std::memory_order_release);
+        slot.m_sequence.notify_all();
+    }
+
+    ALWAYS_INLINE static T consume(Slot& slot, size_t position)
+    {
+        T& element = slot.element();
+        T result = TK::move(element);
+        element.~T();
+        slot.m_sequence.store(position + capacity, std::memory_order_release);
+        slot.m_sequence.notify_all();
+        return result;
+    }
+
+private:
+    alignas(cache_line_size) std::atomic<size_t> m_tail { 0 };
+    alignas(cache_line_size) std::atomic<size_t> m_head { 0 };
+    alignas(cache_line_size) Slot* const m_slots;
+};
+
+}
+
+using TK::MPMCQueue;
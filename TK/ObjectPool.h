@@ -0,0 +1,266 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Definitions.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+
+// Routes every `new` and `delete` of `ClassName` through `ObjectPool<ClassName>`
+// That covers `make_ref`, `make_own` and `make_box`, as well as `RefCounted::deref`, `OwnPtr` and `Box` which delete their objects
+// Derived classes inherit the operators, but their objects are of another size and go to the global heap unless they are pooled too
+#define TK_MAKE_POOLED(ClassName) \
+    public: \
+        static void* operator new(size_t size) { return TK::ObjectPool<ClassName>::allocate(size); } \
+        static void* operator new(size_t, void* ptr) noexcept { return ptr; } \
+        static void operator delete(void* ptr, size_t size) { TK::ObjectPool<ClassName>::deallocate(ptr, size); } \
+        static void operator delete(void*, void*) noexcept { }
+
+namespace TK {
+
+struct ObjectPoolStats {
+    size_t hits { 0 };       // Allocations served by slots the pool already had
+    size_t misses { 0 };     // Allocations which had to carve a new slab out of the global heap
+    size_t bytes_held { 0 }; // Slab memory owned by the pool, whether its slots are in use or not
+};
+
+/* Per-Type Object Pool */
+// Every thread keeps a cache of free slots, so allocating and freeing is a pointer pop and push in the common case
+// Caches refill from and spill over to a global free list in batches, which is the only place taking a lock
+// Slabs are never given back to the heap, the memory of a type's peak population stays around for reuse
+template<typename T>
+class ObjectPool {
+    TK_MAKE_NONCOPYABLE(ObjectPool)
+    TK_MAKE_NONMOVABLE(ObjectPool)
+
+public:
+    static constexpr size_t slots_per_slab = 64;
+    static constexpr size_t max_cached_slots = 2 * slots_per_slab;
+
+    static void* allocate(size_t size)
+    {
+        if (size != sizeof(T)) [[unlikely]]
+            return DefaultAllocator().allocate(size, alignof(T));
+
+        ThreadCache& cache = s_cache;
+        if (FreeSlot* slot = cache.m_free_list) [[likely]] {
+            cache.m_free_list = slot->m_next;
+            cache.m_count--;
+            increment(cache.m_hits);
+            return slot;
+        }
+
+        return the().allocate_slow(cache);
+    }
+
+    static void deallocate(void* ptr, size_t size)
+    {
+        if (!ptr)
+            return;
+
+        if (size != sizeof(T)) [[unlikely]] {
+            DefaultAllocator().deallocate(ptr, size, alignof(T));
+            return;
+        }
+
+        ThreadCache& cache = s_cache;
+        if (cache.m_state != CacheState::Active || cache.m_count == max_cached_slots) [[unlikely]] {
+            the().deallocate_slow(cache, ptr);
+            return;
+        }
+
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        slot->m_next = cache.m_free_list;
+        cache.m_free_list = slot;
+        cache.m_count++;
+    }
+
+    static ObjectPoolStats stats() { return the().collect_stats(); }
+
+private:
+    struct FreeSlot {
+        FreeSlot* m_next;
+    };
+
+    static constexpr size_t slot_alignment = alignof(T) < alignof(FreeSlot) ? alignof(FreeSlot) : alignof(T);
+    static constexpr size_t slot_size = ((sizeof(T) < sizeof(FreeSlot) ? sizeof(FreeSlot) : sizeof(T)) + slot_alignment - 1) / slot_alignment * slot_alignment;
+    static constexpr size_t slab_size = slot_size * slots_per_slab;
+
+    enum class CacheState : unsigned char {
+        Unregistered,
+        Active,
+        Retired,
+    };
+
+    // Trivially destructible, so that destructors running while the thread is torn down can still reach it
+    struct ThreadCache {
+        FreeSlot* m_free_list { nullptr };
+        size_t m_count { 0 };
+        CacheState m_state { CacheState::Unregistered };
+        ThreadCache* m_next { nullptr };
+
+        // Only written by the owning thread, but read by `stats()` from any thread
+        std::atomic<size_t> m_hits { 0 };
+        std::atomic<size_t> m_misses { 0 };
+    };
+
+    // Hands the slots cached by a thread back to the pool once the thread exits
+    struct ThreadCacheReaper {
+        ~ThreadCacheReaper() { the().retire(s_cache); }
+    };
+
+    ObjectPool() = default;
+
+    // Never destroyed, objects freed by static destructors must still find their pool
+    static ObjectPool& the()
+    {
+        static ObjectPool* pool = new ObjectPool;
+        return *pool;
+    }
+
+    // A plain load and store, since the counter has a single writer
+    ALWAYS_INLINE static void increment(std::atomic<size_t>& counter, size_t amount = 1)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+    }
+
+    NEVER_INLINE void* allocate_slow(ThreadCache& cache)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (cache.m_state == CacheState::Unregistered)
+            register_cache(cache);
+
+        bool is_miss = !m_free_list;
+        if (is_miss)
+            carve_slab();
+
+        FreeSlot* slot = m_free_list;
+        m_free_list = slot->m_next;
+        m_free_count--;
+
+        if (cache.m_state != CacheState::Active) {
+            (is_miss ? m_retired_misses : m_retired_hits)++;
+            return slot;
+        }
+        increment(is_miss ? cache.m_misses : cache.m_hits);
+
+        // Refill the cache with a batch, so that the next allocations do not need the lock
+        while (m_free_list && cache.m_count < slots_per_slab) {
+            FreeSlot* next = m_free_list;
+            m_free_list = next->m_next;
+            m_free_count--;
+            next->m_next = cache.m_free_list;
+            cache.m_free_list = next;
+            cache.m_count++;
+        }
+
+        return slot;
+    }
+
+    NEVER_INLINE void deallocate_slow(ThreadCache& cache, void* ptr)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+        if (cache.m_state == CacheState::Unregistered)
+            register_cache(cache);
+
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        if (cache.m_state != CacheState::Active) {
+            slot->m_next = m_free_list;
+            m_free_list = slot;
+            m_free_count++;
+            return;
+        }
+
+        // Spill half of a full cache, so that a thread which only frees does not take the lock every time
+        while (cache.m_count > max_cached_slots / 2) {
+            FreeSlot* spilled = cache.m_free_list;
+            cache.m_free_list = spilled->m_next;
+            cache.m_count--;
+            spilled->m_next = m_free_list;
+            m_free_list = spilled;
+            m_free_count++;
+        }
+
+        slot->m_next = cache.m_free_list;
+        cache.m_free_list = slot;
+        cache.m_count++;
+    }
+
+    void register_cache(ThreadCache& cache)
+    {
+        // Touching the reaper is what schedules its destructor at thread exit
+        [[maybe_unused]] auto* reaper = &s_reaper;
+
+        cache.m_state = CacheState::Active;
+        cache.m_next = m_caches;
+        m_caches = &cache;
+    }
+
+    void retire(ThreadCache& cache)
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        while (FreeSlot* slot = cache.m_free_list) {
+            cache.m_free_list = slot->m_next;
+            slot->m_next = m_free_list;
+            m_free_list = slot;
+            m_free_count++;
+        }
+        cache.m_count = 0;
+
+        m_retired_hits += cache.m_hits.load(std::memory_order_relaxed);
+        m_retired_misses += cache.m_misses.load(std::memory_order_relaxed);
+
+        for (ThreadCache** link = &m_caches; *link; link = &(*link)->m_next) {
+            if (*link == &cache) {
+                *link = cache.m_next;
+                break;
+            }
+        }
+        cache.m_next = nullptr;
+        cache.m_state = CacheState::Retired;
+    }
+
+    void carve_slab()
+    {
+        auto* slab = static_cast<unsigned char*>(DefaultAllocator().allocate(slab_size, slot_alignment));
+        for (size_t i = slots_per_slab; i-- > 0; ) {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(slab + i * slot_size);
+            slot->m_next = m_free_list;
+            m_free_list = slot;
+        }
+        m_free_count += slots_per_slab;
+        m_bytes_held += slab_size;
+    }
+
+    ObjectPoolStats collect_stats()
+    {
+        std::lock_guard<std::mutex> guard(m_lock);
+
+        ObjectPoolStats stats { m_retired_hits, m_retired_misses, m_bytes_held };
+        for (ThreadCache* cache = m_caches; cache; cache = cache->m_next) {
+            stats.hits += cache->m_hits.load(std::memory_order_relaxed);
+            stats.misses += cache->m_misses.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+private:
+    inline static thread_local ThreadCache s_cache { };
+    inline static thread_local ThreadCacheReaper s_reaper { };
+
+    std::mutex m_lock;
+    FreeSlot* m_free_list { nullptr };
+    size_t m_free_count { 0 };
+    ThreadCache* m_caches { nullptr };
+    size_t m_retired_hits { 0 };
+    size_t m_retired_misses { 0 };
+    size_t m_bytes_held { 0 };
+};
+
+}
+
+using TK::ObjectPool;
+using TK::ObjectPoolStats;
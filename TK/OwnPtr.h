@@ -8,10 +8,20 @@
 
 namespace TK {
 
-template<typename T>
+// Frees what `new` allocated, the way every `OwnPtr` does unless it is given another deleter
+struct DefaultDelete {
+    template<typename T>
+    ALWAYS_INLINE void operator()(T* ptr) const { delete ptr; }
+};
+
+// `Deleter` destroys the object and frees its memory, objects living in an `Arena` use `ArenaDelete` for instance
+template<typename T, typename Deleter = DefaultDelete>
 class [[nodiscard]] OwnPtr {
     TK_MAKE_NONCOPYABLE(OwnPtr)
 
+    template<typename U, typename OtherDeleter>
+    friend class OwnPtr;
+
 public:
     ALWAYS_INLINE OwnPtr() = default;
     ALWAYS_INLINE ~OwnPtr() { clear(); }
@@ -32,14 +42,22 @@ public:
     {
     }
 
+    ALWAYS_INLINE OwnPtr(const T* ptr, Deleter deleter)
+        : m_ptr(const_cast<T*>(ptr))
+        , m_deleter(std::move(deleter))
+    {
+    }
+
     ALWAYS_INLINE OwnPtr(OwnPtr&& other) noexcept
         : m_ptr(other.release())
+        , m_deleter(std::move(other.m_deleter))
     {
     }
 
     template<typename U>
-    ALWAYS_INLINE OwnPtr(OwnPtr<U>&& other) noexcept requires(std::is_convertible<U*, T*>::value)
+    ALWAYS_INLINE OwnPtr(OwnPtr<U, Deleter>&& other) noexcept requires(std::is_convertible<U*, T*>::value)
         : m_ptr(other.release())
+        , m_deleter(std::move(other.m_deleter))
     {
     }
 
@@ -70,7 +88,7 @@ public:
     }
 
     template<typename U>
-    OwnPtr& operator=(OwnPtr<U>&& other) noexcept requires(std::is_convertible<U*, T*>::value)
+    OwnPtr& operator=(OwnPtr<U, Deleter>&& other) noexcept requires(std::is_convertible<U*, T*>::value)
     {
         OwnPtr temp { std::move(other) };
         swap(temp);
@@ -95,12 +113,14 @@ public:
     void swap(OwnPtr& other) noexcept
     {
         std::swap(m_ptr, other.m_ptr);
+        std::swap(m_deleter, other.m_deleter);
     }
 
     template<typename U>
-    void swap(OwnPtr<U>& other) noexcept requires(std::is_convertible<U*, T*>::value)
+    void swap(OwnPtr<U, Deleter>& other) noexcept requires(std::is_convertible<U*, T*>::value)
     {
         std::swap(m_ptr, other.m_ptr);
+        std::swap(m_deleter, other.m_deleter);
     }
 
     // Release the raw pointer it owns, and the pointer owned becomes `nullptr`
@@ -120,70 +140,72 @@ private:
 
     ALWAYS_INLINE void clear()
     {
-        delete m_ptr;
+        if (m_ptr)
+            m_deleter(m_ptr);
         m_ptr = nullptr;
     }
 
 private:
     T* m_ptr { nullptr };
+    [[no_unique_address]] Deleter m_deleter { };
 };
 
-template<typename T>
-void swap(OwnPtr<T>& a, OwnPtr<T>& b) noexcept
+template<typename T, typename D>
+void swap(OwnPtr<T, D>& a, OwnPtr<T, D>& b) noexcept
 {
     a.swap(b);
 }
 
-template<typename T, typename U>
-void swap(OwnPtr<T>& a, OwnPtr<U>& b) noexcept requires(std::is_convertible<U*, T*>::value)
+template<typename T, typename U, typename D>
+void swap(OwnPtr<T, D>& a, OwnPtr<U, D>& b) noexcept requires(std::is_convertible<U*, T*>::value)
 {
     a.swap(b);
 }
 
-template<typename T, typename U>
-ALWAYS_INLINE bool operator==(const OwnPtr<T>& a, U* b) requires(std::is_convertible<U*, T*>::value)
+template<typename T, typename U, typename D>
+ALWAYS_INLINE bool operator==(const OwnPtr<T, D>& a, U* b) requires(std::is_convertible<U*, T*>::value)
 {
     return a.ptr() == b;
 }
 
-template<typename T, typename U>
-ALWAYS_INLINE bool operator!=(const OwnPtr<T>& a, U* b) requires(std::is_convertible<U*, T*>::value)
+template<typename T, typename U, typename D>
+ALWAYS_INLINE bool operator!=(const OwnPtr<T, D>& a, U* b) requires(std::is_convertible<U*, T*>::value)
 {
     return a.ptr() != b;
 }
 
-template<typename T, typename U>
-ALWAYS_INLINE bool operator==(T* a, const OwnPtr<U>& b) requires(std::is_convertible<U*, T*>::value)
+template<typename T, typename U, typename D>
+ALWAYS_INLINE bool operator==(T* a, const OwnPtr<U, D>& b) requires(std::is_convertible<U*, T*>::value)
 {
     return a == b.ptr();
 }
 
-template<typename T, typename U>
-ALWAYS_INLINE bool operator!=(T* a, const OwnPtr<U>& b) requires(std::is_convertible<U*, T*>::value)
+template<typename T, typename U, typename D>
+ALWAYS_INLINE bool operator!=(T* a, const OwnPtr<U, D>& b) requires(std::is_convertible<U*, T*>::value)
 {
     return a != b.ptr();
 }
 
-template<typename T>
-ALWAYS_INLINE bool operator==(const OwnPtr<T>& a, decltype(nullptr))
+template<typename T, typename D>
+ALWAYS_INLINE bool operator==(const OwnPtr<T, D>& a, decltype(nullptr))
 {
     return a.ptr() == nullptr;
 }
 
-template<typename T>
-ALWAYS_INLINE bool operator!=(const OwnPtr<T>& a, decltype(nullptr))
+template<typename T, typename D>
+ALWAYS_INLINE bool operator!=(const OwnPtr<T, D>& a, decltype(nullptr))
 {
     return a.ptr() != nullptr;
 }
 
-template<typename T>
-ALWAYS_INLINE bool operator==(decltype(nullptr), const OwnPtr<T>& b)
+template<typename T, typename D>
+ALWAYS_INLINE bool operator==(decltype(nullptr), const OwnPtr<T, D>& b)
 {
     return nullptr == b.ptr();
 }
 
-template<typename T>
-ALWAYS_INLINE bool operator!=(decltype(nullptr), const OwnPtr<T>& b)
+template<typename T, typename D>
+ALWAYS_INLINE bool operator!=(decltype(nullptr), const OwnPtr<T, D>& b)
 {
     return nullptr != b.ptr();
 }
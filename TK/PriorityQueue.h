@@ -1,77 +1,444 @@
 #pragma once
 
+#include "Assertions.h"
+#include "Definitions.h"
 #include "Vector.h"
 #include "Utility.h"
+#include <cstddef>
+#include <functional>
 
 namespace TK {
 
-// Max Binary Heap
+namespace Internal {
 
-template<typename T>
+/* D-ary Heap Operations */
+// Sifting moves elements into a hole instead of swapping them, the element being sifted is only written once it found its place
+// `place(index, element)` does that write, which lets the indexed queue keep track of where every element went
+template<size_t arity>
+struct DaryHeap {
+    static_assert(arity >= 2, "Heap arity must be at least 2");
+
+    ALWAYS_INLINE static size_t parent_of(size_t index) { return (index - 1) / arity; }
+    ALWAYS_INLINE static size_t first_child_of(size_t index) { return index * arity + 1; }
+
+    // `compare(a, b)` tells whether `a` ranks below `b`, the highest ranked element ends up at the root
+    template<typename Elements, typename Element, typename Compare, typename Place>
+    static void sift_up(Elements& elements, size_t index, Element&& element, Compare& compare, Place place)
+    {
+        while (index > 0) {
+            size_t parent = parent_of(index);
+            if (!compare(elements[parent], element))
+                break;
+
+            place(index, TK::move(elements[parent]));
+            index = parent;
+        }
+        place(index, TK::move(element));
+    }
+
+    template<typename Elements, typename Element, typename Compare, typename Place>
+    static void sift_down(Elements& elements, size_t index, Element&& element, Compare& compare, Place place)
+    {
+        size_t size = elements.size();
+        while (true) {
+            size_t first_child = first_child_of(index);
+            if (first_child >= size)
+                break;
+
+            // The children of a node are adjacent, so scanning all of them touches one or two cache lines
+            size_t last_child = size - first_child < arity ? size : first_child + arity;
+            size_t best_child = first_child;
+            for (size_t child = first_child + 1; child < last_child; child++) {
+                if (compare(elements[best_child], elements[child]))
+                    best_child = child;
+            }
+
+            if (!compare(element, elements[best_child]))
+                break;
+
+            place(index, TK::move(elements[best_child]));
+            index = best_child;
+        }
+        place(index, TK::move(element));
+    }
+
+    // Fills the hole left at the root by a pop: the hole walks down to a leaf along the best children, then `element` sifts up from there
+    // That saves a comparison per level over `sift_down`, since the last element of a heap usually belongs near the bottom anyway
+    template<typename Elements, typename Element, typename Compare, typename Place>
+    static void sift_hole_from_root(Elements& elements, Element&& element, Compare& compare, Place place)
+    {
+        size_t size = elements.size();
+        size_t index = 0;
+        while (true) {
+            size_t first_child = first_child_of(index);
+            if (first_child >= size)
+                break;
+
+            size_t last_child = size - first_child < arity ? size : first_child + arity;
+            size_t best_child = first_child;
+            for (size_t child = first_child + 1; child < last_child; child++) {
+                if (compare(elements[best_child], elements[child]))
+                    best_child = child;
+            }
+
+            place(index, TK::move(elements[best_child]));
+            index = best_child;
+        }
+        sift_up(elements, index, TK::move(element), compare, place);
+    }
+
+    // Floyd's bottom-up construction, O(n) in total since most nodes sit near the leaves
+    template<typename Elements, typename Compare, typename Place>
+    static void heapify(Elements& elements, Compare& compare, Place place)
+    {
+        heapify_from(elements, 0, compare, place);
+    }
+
+    // Restores the heap after elements were appended from `first_appended` on, the ones before it being a heap already
+    // Only the ancestors of the appended elements are sifted, level by level from the bottom, so that every subtree is a heap by the time its root is sifted
+    template<typename Elements, typename Compare, typename Place>
+    static void heapify_from(Elements& elements, size_t first_appended, Compare& compare, Place place)
+    {
+        size_t size = elements.size();
+        if (size < 2 || first_appended >= size)
+            return;
+
+        size_t first = first_appended ? first_appended : 1;
+        size_t last = size - 1;
+        do {
+            first = parent_of(first);
+            last = parent_of(last);
+            for (size_t index = last + 1; index-- > first; ) {
+                auto element = TK::move(elements[index]);
+                sift_down(elements, index, TK::move(element), compare, place);
+            }
+        } while (first > 0);
+    }
+};
+
+} // namespace Internal
+
+/* D-ary Heap */
+// A max heap under `Compare` like `std::priority_queue`, so `std::greater<T>` turns it into a min heap
+// A node has `arity` children instead of 2: the heap is shallower and the children of a node share cache lines,
+// which pays off since sifting down, the costly half of a `pop()`, reads all of them anyway
+template<typename T, typename Compare = std::less<T>, size_t arity = 4>
 class PriorityQueue {
+    using Heap = Internal::DaryHeap<arity>;
+
+public:
+    using ContainerType = Vector<T>;
+    using SizeType = typename ContainerType::SizeType;
+    using ValueType = T;
+
 public:
     PriorityQueue() = default;
     ~PriorityQueue() = default;
 
-    unsigned size() const { return m_items.size(); }
+    explicit PriorityQueue(const Compare& compare)
+        : m_compare(compare)
+    {
+    }
+
+    // Takes the elements over without copying them and builds the heap in O(n)
+    explicit PriorityQueue(ContainerType&& elements, const Compare& compare = Compare())
+        : m_elements(TK::move(elements))
+        , m_compare(compare)
+    {
+        Heap::heapify(m_elements, m_compare, placer());
+    }
+
+    // Builds the heap in O(n) rather than pushing every element
+    template<typename InputIt>
+    PriorityQueue(InputIt first, InputIt last, const Compare& compare = Compare())
+        : m_compare(compare)
+    {
+        for (; first != last; ++first)
+            m_elements.push_back(*first);
+        Heap::heapify(m_elements, m_compare, placer());
+    }
+
+    SizeType size() const { return m_elements.size(); }
     bool is_empty() const { return size() == 0; }
 
-    void push(T&& element)
+    void push(const T& element) { emplace(element); }
+    void push(T&& element) { emplace(TK::move(element)); }
+
+    template<typename... Args>
+    void emplace(Args&&... args)
+    {
+        m_elements.emplace_back(TK::forward<Args>(args)...);
+        T element = TK::move(m_elements.back());
+        Heap::sift_up(m_elements, size() - 1, TK::move(element), m_compare, placer());
+    }
+
+    // Appends everything first and restores the heap once, which is O(n + k) when many elements come at once
+    // Taken by forwarding reference since `Vector` only iterates when non-const, the elements are copied either way
+    template<typename Range>
+    void push_bulk(Range&& range)
     {
-        unsigned i = size();
-        m_elements.emplace_back(forward<T>(element));
-        sift_up(i);
+        SizeType first_appended = size();
+        for (auto&& element : range)
+            m_elements.push_back(static_cast<const T&>(element));
+        restore_after_append(first_appended);
+    }
+
+    void push_bulk(ContainerType&& elements)
+    {
+        SizeType first_appended = size();
+        if (is_empty()) {
+            m_elements = TK::move(elements);
+        } else {
+            m_elements.reserve(size() + elements.size());
+            for (T& element : elements)
+                m_elements.push_back(TK::move(element));
+            elements.clear();
+        }
+        restore_after_append(first_appended);
     }
 
     T pop()
     {
-        swap(m_elements.front(), m_elements.back());
-        T result = m_elements.back();
-        m_elements.pop_back();
-        sift_down(0);
+        ASSERT(!is_empty());
+        T result = TK::move(m_elements.front());
+        remove_top();
         return result;
     }
 
-    const T& top() const { return m_elements[0]; }
-    T& top() { return m_elements[0]; }
+    // Moves up to `count` elements into `out` in priority order, returns how many were popped
+    template<typename Container>
+    SizeType pop_n(SizeType count, Container& out)
+    {
+        if (count > size())
+            count = size();
+        if constexpr (requires { out.reserve(out.size() + count); })
+            out.reserve(out.size() + count);
+
+        for (SizeType i = 0; i < count; i++) {
+            out.push_back(TK::move(m_elements.front()));
+            remove_top();
+        }
+        return count;
+    }
+
+    const T& top() const { return m_elements.front(); }
+
+    void clear() { m_elements.clear(); }
 
 private:
-    ALWAYS_INLINE unsigned parent_of(unsigned i) const { return i / 2; }
-    ALWAYS_INLINE unsigned left_child_of(unsigned i) const  { return i * 2 + 1; }
-    ALWAYS_INLINE unsigned right_child_of(unsigned i) const { return i * 2 + 2; }
+    auto placer()
+    {
+        return [this](size_t index, T&& element) { m_elements[index] = TK::move(element); };
+    }
 
-    void sift_up(unsigned i)
+    // The top has been moved out already, its hole is filled by the last element
+    void remove_top()
     {
-        while (i) {
-            unsigned parent = parent_of(i);
-            if (m_elements[parent] > m_elements[i])
-                break;
+        T last = TK::move(m_elements.back());
+        m_elements.pop_back();
+        if (!is_empty())
+            Heap::sift_hole_from_root(m_elements, TK::move(last), m_compare, placer());
+    }
 
-            swap(m_elements[i], m_elements[parent]);
-            i = parent;
+    void restore_after_append(SizeType first_appended)
+    {
+        SizeType appended = size() - first_appended;
+
+        // A few elements are cheaper to sift up one by one, a batch as large as the heap is cheaper to rebuild it from
+        if (appended < 8) {
+            for (SizeType index = first_appended; index < size(); index++) {
+                T element = TK::move(m_elements[index]);
+                Heap::sift_up(m_elements, index, TK::move(element), m_compare, placer());
+            }
+        } else if (appended >= first_appended) {
+            Heap::heapify(m_elements, m_compare, placer());
+        } else {
+            Heap::heapify_from(m_elements, first_appended, m_compare, placer());
         }
     }
 
-    void sift_down(unsigned i)
+private:
+    ContainerType m_elements { };
+    [[no_unique_address]] Compare m_compare { };
+};
+
+/* Indexed D-ary Heap */
+// A `PriorityQueue` whose elements can be found again through the handle `push()` returned,
+// to change their priority or remove them in O(log n), as needed by Dijkstra or timer wheels
+// A handle stays valid until its element is popped or erased, after which it may be reused for a later `push()`
+template<typename T, typename Compare = std::less<T>, size_t arity = 4>
+class IndexedPriorityQueue {
+    using Heap = Internal::DaryHeap<arity>;
+
+public:
+    class Handle {
+        friend IndexedPriorityQueue;
+
+    public:
+        Handle() = default;
+
+        bool operator==(const Handle& other) const { return m_id == other.m_id; }
+        bool operator!=(const Handle& other) const { return m_id != other.m_id; }
+
+    private:
+        explicit Handle(size_t id)
+            : m_id(id)
+        {
+        }
+
+        size_t m_id { static_cast<size_t>(-1) };
+    };
+
+private:
+    struct Entry {
+        T m_value;
+        size_t m_id;
+    };
+
+    struct EntryCompare {
+        bool operator()(const Entry& lhs, const Entry& rhs) { return m_compare(lhs.m_value, rhs.m_value); }
+
+        [[no_unique_address]] Compare m_compare;
+    };
+
+public:
+    using SizeType = typename Vector<Entry>::SizeType;
+    using ValueType = T;
+
+public:
+    IndexedPriorityQueue() = default;
+    ~IndexedPriorityQueue() = default;
+
+    explicit IndexedPriorityQueue(const Compare& compare)
+        : m_compare { compare }
     {
-        while (left_child_of(i) < size()) {
-            unsigned left_child = left_child_of(i);
-            unsigned right_child = right_child_of(i);
+    }
+
+    SizeType size() const { return m_entries.size(); }
+    bool is_empty() const { return size() == 0; }
 
-            unsigned max_child = left_child;
-            if (right_child < size() && m_elements[right_child] > m_elements[left_child])
-                max_child = right_child;
+    Handle push(const T& value) { return emplace(value); }
+    Handle push(T&& value) { return emplace(TK::move(value)); }
 
-            if (m_elements[max_child] < m_elements[i])
-                break;
+    template<typename... Args>
+    Handle emplace(Args&&... args)
+    {
+        size_t id = acquire_id();
+        m_entries.emplace_back(Entry { T(TK::forward<Args>(args)...), id });
+        Entry entry = TK::move(m_entries.back());
+        Heap::sift_up(m_entries, size() - 1, TK::move(entry), m_compare, placer());
+        return Handle(id);
+    }
+
+    const T& top() const { return m_entries.front().m_value; }
+    Handle top_handle() const { return Handle(m_entries.front().m_id); }
+
+    T pop()
+    {
+        ASSERT(!is_empty());
+        release_id(m_entries.front().m_id);
+        T result = TK::move(m_entries.front().m_value);
+        remove_at(0);
+        return result;
+    }
 
-            swap(m_elements[i], m_elements[max_child]);
-            i = max_child;
+    [[nodiscard]] bool contains(Handle handle) const { return handle.m_id < m_positions.size() && m_positions[handle.m_id] != npos; }
+
+    const T& get(Handle handle) const { return m_entries[position_of(handle)].m_value; }
+
+    // Sifts the element whichever way its new value takes it
+    void update(Handle handle, T value)
+    {
+        size_t index = position_of(handle);
+        Entry entry { TK::move(value), handle.m_id };
+        if (index > 0 && m_compare(m_entries[Heap::parent_of(index)], entry))
+            Heap::sift_up(m_entries, index, TK::move(entry), m_compare, placer());
+        else
+            Heap::sift_down(m_entries, index, TK::move(entry), m_compare, placer());
+    }
+
+    // Moves the element towards the top, the new value must not rank below the old one
+    // Named after the min heap (`std::greater<T>`) most algorithms use, where ranking higher means a smaller key
+    void decrease_key(Handle handle, T value)
+    {
+        size_t index = position_of(handle);
+        Entry entry { TK::move(value), handle.m_id };
+        ASSERT_WITH_MSG(!m_compare(entry, m_entries[index]), "decrease_key() would move the element away from the top");
+        Heap::sift_up(m_entries, index, TK::move(entry), m_compare, placer());
+    }
+
+    T erase(Handle handle)
+    {
+        size_t index = position_of(handle);
+        release_id(handle.m_id);
+        T result = TK::move(m_entries[index].m_value);
+        remove_at(index);
+        return result;
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_positions.clear();
+        m_free_ids.clear();
+    }
+
+private:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    auto placer()
+    {
+        return [this](size_t index, Entry&& entry) {
+            m_positions[entry.m_id] = index;
+            m_entries[index] = TK::move(entry);
+        };
+    }
+
+    size_t position_of(Handle handle) const
+    {
+        ASSERT(contains(handle));
+        return m_positions[handle.m_id];
+    }
+
+    size_t acquire_id()
+    {
+        if (!m_free_ids.empty()) {
+            size_t id = m_free_ids.back();
+            m_free_ids.pop_back();
+            return id;
         }
+        m_positions.push_back(npos);
+        return m_positions.size() - 1;
+    }
+
+    void release_id(size_t id)
+    {
+        m_positions[id] = npos;
+        m_free_ids.push_back(id);
+    }
+
+    // Fills the hole at `index` with the last entry, which may have to go up as well as down from there
+    void remove_at(size_t index)
+    {
+        Entry last = TK::move(m_entries.back());
+        m_entries.pop_back();
+        if (index == size())
+            return;
+
+        if (index > 0 && m_compare(m_entries[Heap::parent_of(index)], last))
+            Heap::sift_up(m_entries, index, TK::move(last), m_compare, placer());
+        else
+            Heap::sift_down(m_entries, index, TK::move(last), m_compare, placer());
     }
 
 private:
-    Vector<T> m_elements { };
+    Vector<Entry> m_entries { };
+    Vector<size_t> m_positions { };
+    Vector<size_t> m_free_ids { };
+    [[no_unique_address]] EntryCompare m_compare { };
 };
 
 }
+
+using TK::PriorityQueue;
+using TK::IndexedPriorityQueue;
@@ -1,12 +1,13 @@
 #pragma once
 
-#include "Vector.h"
+#include "RingBuffer.h"
 #include "Utility.h"
 
 namespace TK {
 
-/* Continuous Queue with Vector as underlying container */
-template<typename T, typename Container = Vector<T>>
+/* Continuous Queue with a RingBuffer as its underlying container */
+// Pushing and popping are amortized O(1), and a queue which has reached its working size no longer allocates
+template<typename T, typename Container = RingBuffer<T>>
 class Queue {
 public:
     using ContainerType = Container;
@@ -15,7 +16,7 @@ public:
     using ConstReference = const T&;
     using Pointer = T*;
     using ConstPointer = const T*;
-    using SizeType = unsigned;
+    using SizeType = typename Container::SizeType;
 
 public:
     Queue() = default;
@@ -27,13 +28,21 @@ public:
     }
 
     Queue(Queue&& other) noexcept
-        : m_container (move(other.m_container))
+        : m_container (TK::move(other.m_container))
     {
     }
 
-    Queue& operator=(const Queue& other) { m_container = other.m_container; }
+    Queue& operator=(const Queue& other)
+    {
+        m_container = other.m_container;
+        return *this;
+    }
 
-    Queue& operator=(Queue&& other) noexcept { m_container = move(other.m_container); }
+    Queue& operator=(Queue&& other) noexcept
+    {
+        m_container = TK::move(other.m_container);
+        return *this;
+    }
 
     T& front() noexcept { return m_container.front(); }
     const T& front() const noexcept { return m_container.front(); }
@@ -42,16 +51,19 @@ public:
     const T& back() const noexcept { return m_container.back(); }
 
     [[nodiscard]] bool empty() const { return m_container.empty(); }
-    unsigned size() const { return m_container.size(); }
+    SizeType size() const { return m_container.size(); }
 
     void push(const T& value) { m_container.push_back(value); }
-    void push(T&& value) { m_container.push_back(move(value)); }
+    void push(T&& value) { m_container.push_back(TK::move(value)); }
 
     template<typename... Args>
-    void emplace(Args... args) { m_container.emplace_back(forward<Args>(args)...); }
+    void emplace(Args... args) { m_container.emplace_back(TK::forward<Args>(args)...); }
 
     void pop() { m_container.pop_front(); }
 
+    // Pre-sizes the queue so that it does not allocate until it holds more than `capacity` elements
+    void reserve(SizeType capacity) { m_container.reserve(capacity); }
+
     void swap(Queue& other) noexcept
     {
         using TK::swap;
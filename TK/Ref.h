@@ -7,8 +7,9 @@
 
 namespace TK {
 
-// Non-Null and Unthread-Safe Reference Counting Pointer
-// `T` must inherit `RefCounted<T>` publicly to use `Ref<T>`
+// Non-Null Reference Counting Pointer
+// `T` must inherit `RefCounted<T>` or `AtomicRefCounted<T>` publicly to use `Ref<T>`
+// Copying and dropping `Ref<T>` is thread-safe only when `T` inherits `AtomicRefCounted<T>`
 
 // A `Ref<T>` may share the resource it holds with `RefPtr<T>`
 // But `RefPtr<T>` may share its resource only when the pointer it holds is not `nullptr`
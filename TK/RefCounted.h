@@ -18,6 +18,15 @@ public:
     ALWAYS_INLINE void ref() const { m_ref_cnt++; }
     ALWAYS_INLINE unsigned ref_count() const { return m_ref_cnt; }
 
+    // Takes a reference only if the object is still alive, which is how a `WeakPtr` gets upgraded
+    ALWAYS_INLINE bool try_ref() const
+    {
+        if (m_ref_cnt == 0)
+            return false;
+        m_ref_cnt++;
+        return true;
+    }
+
 protected:
     RefCountedBase() = default;
     ~RefCountedBase() = default;
@@ -45,8 +54,18 @@ class RefCounted : public Internal::RefCountedBase {
 public:
     ALWAYS_INLINE void deref() const
     {
-        if (deref_base())
-            delete const_cast<T*>(static_cast<const T*>(this));
+        if (!deref_base())
+            return;
+
+        T* object = const_cast<T*>(static_cast<const T*>(this));
+
+        // Objects made by `make_ref_with_weak` share their storage with their weak flag, which frees it
+        if constexpr (requires { object->destroy_if_fused(); }) {
+            if (object->destroy_if_fused())
+                return;
+        }
+
+        delete object;
     }
 
 protected:
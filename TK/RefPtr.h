@@ -7,11 +7,21 @@
 
 namespace TK {
 
-// Nullable and Unthread-Safe Reference Counting Pointer
-// `T` must inherit `RefCounted<T>` publicly to use `RefPtr<T>`
+// Nullable Reference Counting Pointer
+// `T` must inherit `RefCounted<T>` or `AtomicRefCounted<T>` publicly to use `RefPtr<T>`
+// Copying and dropping `RefPtr<T>` is thread-safe only when `T` inherits `AtomicRefCounted<T>`
+
+template<typename T>
+class RefPtr;
+
+template<typename T>
+RefPtr<T> adopt_ref_if_nonnull(T* ptr);
 
 template<typename T>
 class [[nodiscard]] RefPtr {
+    template<typename U>
+    friend RefPtr<U> adopt_ref_if_nonnull(U* ptr);
+
 public:
     ALWAYS_INLINE RefPtr() = default;
     ALWAYS_INLINE ~RefPtr() { clear(); }
@@ -180,6 +190,13 @@ public:
     }
 
 private:
+    struct AdoptTag { };
+
+    ALWAYS_INLINE RefPtr(AdoptTag, T* ptr)
+        : m_ptr(ptr)
+    {
+    }
+
     ALWAYS_INLINE bool is_null() const { return !m_ptr; }
     ALWAYS_INLINE T* as_ptr() const { return m_ptr; }
     ALWAYS_INLINE T* as_nonnull_ptr() const
@@ -210,6 +227,13 @@ private:
     T* m_ptr { nullptr };
 };
 
+// Wraps a reference the caller already holds, without changing the reference count
+template<typename T>
+ALWAYS_INLINE RefPtr<T> adopt_ref_if_nonnull(T* ptr)
+{
+    return RefPtr<T> { typename RefPtr<T>::AdoptTag { }, ptr };
+}
+
 template<typename T>
 void swap(RefPtr<T>& a, RefPtr<T>& b)
 {
@@ -0,0 +1,305 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Assertions.h"
+#include "Definitions.h"
+#include "Utility.h"
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <initializer_list>
+
+namespace TK {
+
+/* Growable Circular Buffer */
+// Elements live in one contiguous power-of-two sized block, so pushing and popping at both ends is amortized O(1)
+// and never allocates once the buffer has grown to its working size
+template<typename T>
+class RingBuffer {
+public:
+    using SizeType = size_t;
+    using ValueType = T;
+    using Reference = T&;
+    using ConstReference = const T&;
+    using Pointer = T*;
+    using ConstPointer = const T*;
+
+private:
+    /* Ring Buffer Iterator */
+    template<typename BufferType, typename ElementType>
+    class RingBufferIterator {
+        friend RingBuffer;
+
+    public:
+        using DifferenceType = std::ptrdiff_t;
+
+        constexpr RingBufferIterator() = default;
+
+        RingBufferIterator& operator++()
+        {
+            m_index++;
+            return *this;
+        }
+
+        RingBufferIterator operator++(int)
+        {
+            RingBufferIterator it = *this;
+            m_index++;
+            return it;
+        }
+
+        RingBufferIterator& operator--()
+        {
+            m_index--;
+            return *this;
+        }
+
+        RingBufferIterator operator--(int)
+        {
+            RingBufferIterator it = *this;
+            m_index--;
+            return it;
+        }
+
+        [[nodiscard]] RingBufferIterator operator+(DifferenceType offset) const { return RingBufferIterator { m_buffer, m_index + offset }; }
+        [[nodiscard]] RingBufferIterator operator-(DifferenceType offset) const { return RingBufferIterator { m_buffer, m_index - offset }; }
+        [[nodiscard]] DifferenceType operator-(const RingBufferIterator& other) const { return static_cast<DifferenceType>(m_index - other.m_index); }
+
+        RingBufferIterator& operator+=(DifferenceType offset)
+        {
+            m_index += offset;
+            return *this;
+        }
+
+        RingBufferIterator& operator-=(DifferenceType offset)
+        {
+            m_index -= offset;
+            return *this;
+        }
+
+        [[nodiscard]] bool operator==(const RingBufferIterator& other) const { return m_index == other.m_index; }
+        [[nodiscard]] bool operator!=(const RingBufferIterator& other) const { return m_index != other.m_index; }
+
+        [[nodiscard]] ElementType& operator*() const { return (*m_buffer)[m_index]; }
+        [[nodiscard]] ElementType* operator->() const { return &(*m_buffer)[m_index]; }
+        [[nodiscard]] ElementType& operator[](DifferenceType offset) const { return (*m_buffer)[m_index + offset]; }
+
+    private:
+        RingBufferIterator(BufferType* buffer, SizeType index)
+            : m_buffer(buffer)
+            , m_index(index)
+        {
+        }
+
+        BufferType* m_buffer { nullptr };
+        SizeType m_index { 0 };
+    };
+
+public:
+    using Iterator = RingBufferIterator<RingBuffer, T>;
+    using ConstIterator = RingBufferIterator<const RingBuffer, const T>;
+
+public:
+    RingBuffer() = default;
+
+    RingBuffer(const RingBuffer& other)
+    {
+        reserve(other.m_size);
+        for (SizeType i = 0; i < other.m_size; i++)
+            new(&m_data[i]) T(other[i]);
+        m_size = other.m_size;
+    }
+
+    RingBuffer(RingBuffer&& other) noexcept
+        : m_data(other.m_data)
+        , m_head(other.m_head)
+        , m_size(other.m_size)
+        , m_capacity(other.m_capacity)
+    {
+        other.m_data = nullptr;
+        other.m_head = 0;
+        other.m_size = 0;
+        other.m_capacity = 0;
+    }
+
+    RingBuffer(std::initializer_list<T> init_list)
+    {
+        reserve(init_list.size());
+        for (const T& obj : init_list)
+            emplace_back(obj);
+    }
+
+    ~RingBuffer()
+    {
+        clear();
+        deallocate(m_data, m_capacity);
+    }
+
+    RingBuffer& operator=(const RingBuffer& other)
+    {
+        if (this == &other)
+            return *this;
+
+        RingBuffer temp { other };
+        swap(temp);
+        return *this;
+    }
+
+    RingBuffer& operator=(RingBuffer&& other) noexcept
+    {
+        if (this == &other)
+            return *this;
+
+        RingBuffer temp { TK::move(other) };
+        swap(temp);
+        return *this;
+    }
+
+    [[nodiscard]] T& operator[](SizeType index) noexcept { return m_data[slot_of(index)]; }
+    [[nodiscard]] const T& operator[](SizeType index) const noexcept { return m_data[slot_of(index)]; }
+
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] SizeType size() const noexcept { return m_size; }
+    [[nodiscard]] SizeType capacity() const noexcept { return m_capacity; }
+
+    [[nodiscard]] T& front() noexcept { return m_data[m_head]; }
+    [[nodiscard]] const T& front() const noexcept { return m_data[m_head]; }
+
+    [[nodiscard]] T& back() noexcept { return m_data[slot_of(m_size - 1)]; }
+    [[nodiscard]] const T& back() const noexcept { return m_data[slot_of(m_size - 1)]; }
+
+    Iterator begin() noexcept { return Iterator(this, 0); }
+    Iterator end() noexcept { return Iterator(this, m_size); }
+
+    ConstIterator begin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator end() const noexcept { return ConstIterator(this, m_size); }
+
+    ConstIterator cbegin() const noexcept { return ConstIterator(this, 0); }
+    ConstIterator cend() const noexcept { return ConstIterator(this, m_size); }
+
+    template<typename... Args>
+    void emplace_back(Args&&... args)
+    {
+        if (m_size == m_capacity)
+            grow(m_size + 1);
+
+        new(&m_data[slot_of(m_size)]) T(TK::forward<Args>(args)...);
+        m_size++;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(TK::move(value)); }
+
+    void pop_back()
+    {
+        if (m_size > 0) {
+            m_data[slot_of(m_size - 1)].~T();
+            m_size--;
+        }
+    }
+
+    template<typename... Args>
+    void emplace_front(Args&&... args)
+    {
+        if (m_size == m_capacity)
+            grow(m_size + 1);
+
+        SizeType head = (m_head - 1) & (m_capacity - 1);
+        new(&m_data[head]) T(TK::forward<Args>(args)...);
+        m_head = head;
+        m_size++;
+    }
+
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(TK::move(value)); }
+
+    void pop_front()
+    {
+        if (m_size > 0) {
+            m_data[m_head].~T();
+            m_head = (m_head + 1) & (m_capacity - 1);
+            m_size--;
+        }
+    }
+
+    void clear() noexcept
+    {
+        for (SizeType i = 0; i < m_size; i++)
+            m_data[slot_of(i)].~T();
+        m_head = 0;
+        m_size = 0;
+    }
+
+    void reserve(SizeType new_capacity)
+    {
+        if (new_capacity > m_capacity)
+            grow(new_capacity);
+    }
+
+    void swap(RingBuffer& other) noexcept
+    {
+        TK::swap(m_data, other.m_data);
+        TK::swap(m_head, other.m_head);
+        TK::swap(m_size, other.m_size);
+        TK::swap(m_capacity, other.m_capacity);
+    }
+
+private:
+    static constexpr SizeType min_capacity = 8;
+
+    ALWAYS_INLINE SizeType slot_of(SizeType index) const { return (m_head + index) & (m_capacity - 1); }
+
+    // Storage comes with the alignment of `T`, which plain `operator new` only guarantees up to the default alignment
+    static void deallocate(T* data, SizeType capacity)
+    {
+        if (data)
+            DefaultAllocator().deallocate(data, capacity * sizeof(T), alignof(T));
+    }
+
+    // Moves the elements into a larger block, unwrapping them so that the front lands at slot 0
+    void grow(SizeType min_capacity_needed)
+    {
+        SizeType new_capacity = m_capacity ? m_capacity : min_capacity;
+        while (new_capacity < min_capacity_needed) {
+            VERIFY_WITH_MSG(new_capacity <= static_cast<SizeType>(-1) / 2 / sizeof(T), "RingBuffer capacity overflow");
+            new_capacity *= 2;
+        }
+
+        T* new_data = static_cast<T*>(DefaultAllocator().allocate(new_capacity * sizeof(T), alignof(T)));
+
+        if constexpr (is_trivially_relocatable<T>::value) {
+            SizeType first_part = m_capacity - m_head < m_size ? m_capacity - m_head : m_size;
+            if (first_part)
+                std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(m_data + m_head), first_part * sizeof(T));
+            if (m_size > first_part)
+                std::memcpy(static_cast<void*>(new_data + first_part), static_cast<const void*>(m_data), (m_size - first_part) * sizeof(T));
+        } else {
+            for (SizeType i = 0; i < m_size; i++) {
+                T& element = m_data[slot_of(i)];
+                new(&new_data[i]) T(TK::move(element));
+                element.~T();
+            }
+        }
+
+        deallocate(m_data, m_capacity);
+        m_data = new_data;
+        m_head = 0;
+        m_capacity = new_capacity;
+    }
+
+private:
+    T* m_data { nullptr };
+    SizeType m_head { 0 };
+    SizeType m_size { 0 };
+    SizeType m_capacity { 0 };
+};
+
+template<typename T>
+void swap(RingBuffer<T>& lhs, RingBuffer<T>& rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+}
+
+using TK::RingBuffer;
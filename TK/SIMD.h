@@ -0,0 +1,354 @@
+#pragma once
+
+#include "Assertions.h"
+#include "Definitions.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if !defined(TK_SIMD_VECTOR_EXTENSIONS) && (defined(__GNUC__) || defined(__clang__))
+#define TK_SIMD_VECTOR_EXTENSIONS 1
+#endif
+
+#if !defined(TK_SIMD_VECTOR_EXTENSIONS)
+#define TK_SIMD_VECTOR_EXTENSIONS 0
+#endif
+
+// Wider kernels are compiled alongside the baseline ones and picked at runtime from what the CPU reports
+#if !defined(TK_SIMD_X86_DISPATCH) && TK_SIMD_VECTOR_EXTENSIONS && defined(__x86_64__)
+#define TK_SIMD_X86_DISPATCH 1
+#endif
+
+#if !defined(TK_SIMD_X86_DISPATCH)
+#define TK_SIMD_X86_DISPATCH 0
+#endif
+
+namespace TK::SIMD {
+
+// Integers and `float`/`double`, `bool` and `long double` have no vector form
+template<typename T>
+static constexpr bool is_vectorizable = (std::is_integral<T>::value && !std::is_same<T, bool>::value)
+    || std::is_same<T, float>::value || std::is_same<T, double>::value;
+
+enum class Level : unsigned char {
+    Scalar,   // No vector extensions in this compiler
+    Baseline, // 16 byte vectors the target always has, SSE2 on x86-64
+    AVX2,     // 32 byte vectors
+    AVX512,   // 64 byte vectors, with AVX-512BW for the byte and word lanes
+};
+
+namespace Internal {
+
+inline Level detect_level()
+{
+#if TK_SIMD_X86_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        return Level::AVX512;
+    if (__builtin_cpu_supports("avx2"))
+        return Level::AVX2;
+    return Level::Baseline;
+#elif TK_SIMD_VECTOR_EXTENSIONS
+    return Level::Baseline;
+#else
+    return Level::Scalar;
+#endif
+}
+
+/* Scalar Kernels */
+// The reference the vector kernels must agree with, and the tail loop of every one of them
+template<typename T>
+struct ScalarKernels {
+    static size_t find(const T* data, size_t count, T value, size_t index = 0)
+    {
+        for (; index < count; index++) {
+            if (data[index] == value)
+                return index;
+        }
+        return count;
+    }
+
+    static size_t count(const T* data, size_t count, T value, size_t index = 0)
+    {
+        size_t matches = 0;
+        for (; index < count; index++)
+            matches += data[index] == value;
+        return matches;
+    }
+
+    static bool equal(const T* lhs, const T* rhs, size_t count, size_t index = 0)
+    {
+        for (; index < count; index++) {
+            if (!(lhs[index] == rhs[index]))
+                return false;
+        }
+        return true;
+    }
+
+    static T min(const T* data, size_t count) { return min(data, count, data[0], 1); }
+    static T max(const T* data, size_t count) { return max(data, count, data[0], 1); }
+
+    static T min(const T* data, size_t count, T result, size_t index)
+    {
+        for (; index < count; index++)
+            result = data[index] < result ? data[index] : result;
+        return result;
+    }
+
+    static T max(const T* data, size_t count, T result, size_t index)
+    {
+        for (; index < count; index++)
+            result = result < data[index] ? data[index] : result;
+        return result;
+    }
+
+    static void fill(T* data, size_t count, T value, size_t index = 0)
+    {
+        for (; index < count; index++)
+            data[index] = value;
+    }
+};
+
+#if TK_SIMD_VECTOR_EXTENSIONS
+
+/* Vector Kernels */
+// Written once with the compiler's generic vector types, the ISA is whatever the calling entry point was compiled for
+// Always inlined for that reason, an outlined copy would be compiled for the baseline
+// No helper takes or returns a vector by value, which would tie it to an ABI the baseline does not have
+template<typename T, size_t vector_bytes>
+struct VectorKernels {
+    // Comparisons yield a mask of signed integers as wide as `T`, all ones where they hold
+    using Lane = std::conditional_t<sizeof(T) == 1, int8_t, std::conditional_t<sizeof(T) == 2, int16_t, std::conditional_t<sizeof(T) == 4, int32_t, int64_t>>>;
+    typedef T Vector __attribute__((vector_size(vector_bytes)));
+    typedef Lane Mask __attribute__((vector_size(vector_bytes)));
+    typedef T UnalignedVector __attribute__((vector_size(vector_bytes), aligned(alignof(T)), may_alias));
+    using Scalar = ScalarKernels<T>;
+
+    static constexpr size_t lanes = vector_bytes / sizeof(T);
+
+    [[gnu::always_inline]] static inline const UnalignedVector& load(const T* data) { return *reinterpret_cast<const UnalignedVector*>(data); }
+    [[gnu::always_inline]] static inline UnalignedVector& load(T* data) { return *reinterpret_cast<UnalignedVector*>(data); }
+
+    [[gnu::always_inline]] static inline bool any(const Mask& mask)
+    {
+        uint64_t words[vector_bytes / sizeof(uint64_t)];
+        std::memcpy(words, &mask, sizeof(words));
+        uint64_t merged = 0;
+        for (size_t i = 0; i < vector_bytes / sizeof(uint64_t); i++)
+            merged |= words[i];
+        return merged != 0;
+    }
+
+    [[gnu::always_inline]] static inline size_t find(const T* data, size_t count, T value)
+    {
+        // Four vectors per test amortize the horizontal reduction, the exact lane is found by the scalar loop
+        // The masks are summed rather than or-ed: GCC lowers an or of 64 byte masks to scalar code before the AVX-512 entry point inlines it
+        Vector needle = Vector { } + value;
+        size_t index = 0;
+        for (; index + 4 * lanes <= count; index += 4 * lanes) {
+            Mask matches = Mask { } - (load(data + index) == needle) - (load(data + index + lanes) == needle)
+                - (load(data + index + 2 * lanes) == needle) - (load(data + index + 3 * lanes) == needle);
+            if (any(matches))
+                break;
+        }
+        return Scalar::find(data, count, value, index);
+    }
+
+    [[gnu::always_inline]] static inline size_t count(const T* data, size_t count, T value)
+    {
+        // Every lane counts its own matches, and is drained before a narrow lane could overflow
+        constexpr size_t max_rounds = sizeof(Lane) < sizeof(size_t) ? (size_t(1) << (8 * sizeof(Lane) - 1)) - 1 : static_cast<size_t>(-1);
+
+        Vector needle = Vector { } + value;
+        size_t matches = 0;
+        size_t index = 0;
+        while (index + lanes <= count) {
+            Mask counters { };
+            for (size_t round = 0; round < max_rounds && index + lanes <= count; round++, index += lanes)
+                counters -= (load(data + index) == needle);
+            for (size_t lane = 0; lane < lanes; lane++)
+                matches += static_cast<size_t>(counters[lane]);
+        }
+        return matches + Scalar::count(data, count, value, index);
+    }
+
+    [[gnu::always_inline]] static inline bool equal(const T* lhs, const T* rhs, size_t count)
+    {
+        size_t index = 0;
+        for (; index + lanes <= count; index += lanes) {
+            Mask differences = load(lhs + index) != load(rhs + index);
+            if (any(differences))
+                return false;
+        }
+        return Scalar::equal(lhs, rhs, count, index);
+    }
+
+    [[gnu::always_inline]] static inline T min(const T* data, size_t count)
+    {
+        if (count < lanes)
+            return Scalar::min(data, count);
+
+        Vector result = load(data);
+        size_t index = lanes;
+        for (; index + lanes <= count; index += lanes) {
+            Vector vector = load(data + index);
+            result = vector < result ? vector : result;
+        }
+
+        T reduced = result[0];
+        for (size_t lane = 1; lane < lanes; lane++)
+            reduced = result[lane] < reduced ? result[lane] : reduced;
+        return Scalar::min(data, count, reduced, index);
+    }
+
+    [[gnu::always_inline]] static inline T max(const T* data, size_t count)
+    {
+        if (count < lanes)
+            return Scalar::max(data, count);
+
+        Vector result = load(data);
+        size_t index = lanes;
+        for (; index + lanes <= count; index += lanes) {
+            Vector vector = load(data + index);
+            result = result < vector ? vector : result;
+        }
+
+        T reduced = result[0];
+        for (size_t lane = 1; lane < lanes; lane++)
+            reduced = reduced < result[lane] ? result[lane] : reduced;
+        return Scalar::max(data, count, reduced, index);
+    }
+
+    [[gnu::always_inline]] static inline void fill(T* data, size_t count, T value)
+    {
+        Vector vector = Vector { } + value;
+        size_t index = 0;
+        for (; index + lanes <= count; index += lanes)
+            load(data + index) = vector;
+        Scalar::fill(data, count, value, index);
+    }
+};
+
+#endif
+
+// One entry point per kernel and level, each compiled for the ISA of its level
+#define TK_SIMD_DEFINE_ENTRY_POINTS(level, target, ...)                                                                                   \
+    template<typename T>                                                                                                                \
+    target size_t find_##level(const T* data, size_t count, T value) { return __VA_ARGS__::find(data, count, value); }                   \
+    template<typename T>                                                                                                                \
+    target size_t count_##level(const T* data, size_t count, T value) { return __VA_ARGS__::count(data, count, value); }                \
+    template<typename T>                                                                                                                \
+    target bool equal_##level(const T* lhs, const T* rhs, size_t count) { return __VA_ARGS__::equal(lhs, rhs, count); }                 \
+    template<typename T>                                                                                                                \
+    target T min_##level(const T* data, size_t count) { return __VA_ARGS__::min(data, count); }                                         \
+    template<typename T>                                                                                                                \
+    target T max_##level(const T* data, size_t count) { return __VA_ARGS__::max(data, count); }                                         \
+    template<typename T>                                                                                                                \
+    target void fill_##level(T* data, size_t count, T value) { __VA_ARGS__::fill(data, count, value); }
+
+#if TK_SIMD_VECTOR_EXTENSIONS
+TK_SIMD_DEFINE_ENTRY_POINTS(baseline, , VectorKernels<T, 16>)
+#else
+TK_SIMD_DEFINE_ENTRY_POINTS(baseline, , ScalarKernels<T>)
+#endif
+
+#if TK_SIMD_X86_DISPATCH
+TK_SIMD_DEFINE_ENTRY_POINTS(avx2, [[gnu::target("avx2")]], VectorKernels<T, 32>)
+TK_SIMD_DEFINE_ENTRY_POINTS(avx512, [[gnu::target("avx512f,avx512bw")]], VectorKernels<T, 64>)
+#endif
+
+#undef TK_SIMD_DEFINE_ENTRY_POINTS
+
+#if TK_SIMD_X86_DISPATCH
+#define TK_SIMD_DISPATCH(kernel, ...)                        \
+    switch (level()) {                                       \
+    case Level::AVX512:                                      \
+        return Internal::kernel##_avx512(__VA_ARGS__);       \
+    case Level::AVX2:                                        \
+        return Internal::kernel##_avx2(__VA_ARGS__);         \
+    default:                                                 \
+        return Internal::kernel##_baseline(__VA_ARGS__);     \
+    }
+#else
+#define TK_SIMD_DISPATCH(kernel, ...) return Internal::kernel##_baseline(__VA_ARGS__);
+#endif
+
+} // namespace Internal
+
+// Detected once, the first time a kernel runs
+inline Level level()
+{
+    static const Level level = Internal::detect_level();
+    return level;
+}
+
+/* Search and Compare Kernels */
+// Work on plain arrays of integers and floating point numbers, `Vector` uses them for its own lookups and comparisons
+// Floating point lanes follow the scalar operators: NaN never compares equal, and `min()`/`max()` are unspecified when one is present
+
+// The index of the first element equal to `value`, or `count` if there is none
+template<typename T>
+size_t find(const T* data, size_t count, T value) requires(is_vectorizable<T>)
+{
+    TK_SIMD_DISPATCH(find, data, count, value)
+}
+
+template<typename T>
+bool contains(const T* data, size_t count, T value) requires(is_vectorizable<T>)
+{
+    return find(data, count, value) != count;
+}
+
+template<typename T>
+size_t count(const T* data, size_t count, T value) requires(is_vectorizable<T>)
+{
+    TK_SIMD_DISPATCH(count, data, count, value)
+}
+
+template<typename T>
+bool equal(const T* lhs, const T* rhs, size_t count) requires(is_vectorizable<T>)
+{
+    // Integers are equal exactly when their bytes are, which the C library compares faster than anything here
+    if constexpr (std::is_integral<T>::value) {
+        return count == 0 || std::memcmp(lhs, rhs, count * sizeof(T)) == 0;
+    } else {
+        TK_SIMD_DISPATCH(equal, lhs, rhs, count)
+    }
+}
+
+template<typename T>
+T min(const T* data, size_t count) requires(is_vectorizable<T>)
+{
+    ASSERT(count > 0);
+    TK_SIMD_DISPATCH(min, data, count)
+}
+
+template<typename T>
+T max(const T* data, size_t count) requires(is_vectorizable<T>)
+{
+    ASSERT(count > 0);
+    TK_SIMD_DISPATCH(max, data, count)
+}
+
+template<typename T>
+void fill(T* data, size_t count, T value) requires(is_vectorizable<T>)
+{
+    // Values made of one repeated byte, zero above all, are what `memset` is for
+    unsigned char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    bool is_byte_pattern = true;
+    for (size_t i = 1; i < sizeof(T); i++)
+        is_byte_pattern &= bytes[i] == bytes[0];
+
+    if (is_byte_pattern) {
+        if (count)
+            std::memset(data, bytes[0], count * sizeof(T));
+        return;
+    }
+    TK_SIMD_DISPATCH(fill, data, count, value)
+}
+
+#undef TK_SIMD_DISPATCH
+
+}
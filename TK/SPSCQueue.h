@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Definitions.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "Utility.h"
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace TK {
+
+/* Single Producer Single Consumer Queue */
+// A bounded lock-free ring for handing elements from exactly one producer thread to exactly one consumer thread
+// Each side owns its index on a cache line of its own, next to a cached copy of the other side's index:
+// the producer only reads the consumer's index when the ring looks full, and the consumer only reads the producer's when it looks empty
+// Batches publish all of their elements with a single store, so the other side sees the index change once per batch
+template<typename T, size_t capacity>
+class SPSCQueue {
+    TK_MAKE_NONCOPYABLE(SPSCQueue)
+    TK_MAKE_NONMOVABLE(SPSCQueue)
+
+    static_assert(capacity >= 2 && (capacity & (capacity - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+public:
+    using SizeType = size_t;
+    using ValueType = T;
+
+public:
+    SPSCQueue()
+        : m_slots(static_cast<T*>(DefaultAllocator().allocate(capacity * sizeof(T), slot_alignment)))
+    {
+    }
+
+    ~SPSCQueue()
+    {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            size_t tail = m_producer.m_tail.load(std::memory_order_acquire);
+            for (size_t head = m_consumer.m_head.load(std::memory_order_relaxed); head != tail; head++)
+                slot(head).~T();
+        }
+        DefaultAllocator().deallocate(m_slots, capacity * sizeof(T), slot_alignment);
+    }
+
+    static constexpr SizeType max_size() { return capacity; }
+
+    /* Producer Side */
+
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(TK::move(value)); }
+
+    template<typename... Args>
+    bool try_emplace(Args&&... args)
+    {
+        size_t tail = m_producer.m_tail.load(std::memory_order_relaxed);
+        if (free_slots(tail) == 0)
+            return false;
+
+        new (&slot(tail)) T(TK::forward<Args>(args)...);
+        m_producer.m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Moves as many of `elements` as fit, returns how many were pushed
+    SizeType try_push_n(T* elements, SizeType count)
+    {
+        size_t tail = m_producer.m_tail.load(std::memory_order_relaxed);
+        size_t available = free_slots(tail, count);
+        if (count > available)
+            count = available;
+
+        for (size_t i = 0; i < count; i++)
+            new (&slot(tail + i)) T(TK::move(elements[i]));
+        if (count)
+            m_producer.m_tail.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    /* Consumer Side */
+
+    bool try_pop(T& out)
+    {
+        size_t head = m_consumer.m_head.load(std::memory_order_relaxed);
+        if (ready_slots(head) == 0)
+            return false;
+
+        T& element = slot(head);
+        out = TK::move(element);
+        element.~T();
+        m_consumer.m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Move assigns up to `count` elements to `out`, returns how many were popped
+    SizeType try_pop_n(T* out, SizeType count)
+    {
+        size_t head = m_consumer.m_head.load(std::memory_order_relaxed);
+        size_t available = ready_slots(head, count);
+        if (count > available)
+            count = available;
+
+        for (size_t i = 0; i < count; i++) {
+            T& element = slot(head + i);
+            out[i] = TK::move(element);
+            element.~T();
+        }
+        if (count)
+            m_consumer.m_head.store(head + count, std::memory_order_release);
+        return count;
+    }
+
+    // The first element, or `nullptr` if the queue looks empty, it stays valid until the consumer pops it
+    T* front()
+    {
+        size_t head = m_consumer.m_head.load(std::memory_order_relaxed);
+        return ready_slots(head) ? &slot(head) : nullptr;
+    }
+
+    /* Either Side */
+
+    // Only a snapshot, the other thread may change it right away
+    [[nodiscard]] SizeType size_approx() const
+    {
+        size_t head = m_consumer.m_head.load(std::memory_order_acquire);
+        size_t tail = m_producer.m_tail.load(std::memory_order_acquire);
+        return tail - head;
+    }
+
+    [[nodiscard]] bool empty_approx() const { return size_approx() == 0; }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+    static constexpr size_t mask = capacity - 1;
+    static constexpr size_t slot_alignment = alignof(T) > cache_line_size ? alignof(T) : cache_line_size;
+
+    ALWAYS_INLINE T& slot(size_t index) { return m_slots[index & mask]; }
+
+    // Looks at the consumer's index only if the cached one does not leave room for `wanted` elements
+    ALWAYS_INLINE size_t free_slots(size_t tail, size_t wanted = 1)
+    {
+        size_t available = capacity - (tail - m_producer.m_cached_head);
+        if (available < wanted) {
+            m_producer.m_cached_head = m_consumer.m_head.load(std::memory_order_acquire);
+            available = capacity - (tail - m_producer.m_cached_head);
+        }
+        return available;
+    }
+
+    // Looks at the producer's index only if the cached one does not show `wanted` elements
+    ALWAYS_INLINE size_t ready_slots(size_t head, size_t wanted = 1)
+    {
+        size_t available = m_consumer.m_cached_tail - head;
+        if (available < wanted) {
+            m_consumer.m_cached_tail = m_producer.m_tail.load(std::memory_order_acquire);
+            available = m_consumer.m_cached_tail - head;
+        }
+        return available;
+    }
+
+    // Indices only ever grow, the slot is the index modulo the capacity
+    struct alignas(cache_line_size) ProducerSide {
+        std::atomic<size_t> m_tail { 0 };
+        size_t m_cached_head { 0 };
+    };
+
+    struct alignas(cache_line_size) ConsumerSide {
+        std::atomic<size_t> m_head { 0 };
+        size_t m_cached_tail { 0 };
+    };
+
+private:
+    ProducerSide m_producer;
+    ConsumerSide m_consumer;
+    alignas(cache_line_size) T* const m_slots;
+};
+
+}
+
+using TK::SPSCQueue;
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Assertions.h"
+#include "Definitions.h"
+#include <cstddef>
+#include <utility>
+
+namespace TK {
+
+/* Slab Allocator for Fixed-Size Nodes */
+// Nodes are carved out of contiguous slabs of `nodes_per_slab` slots and recycled through a free list,
+// slabs are only given back to the heap when the allocator is destroyed
+// Every allocation must have the same size, which makes it a good fit for the nodes of a single container
+template<size_t nodes_per_slab = 64, typename BackingAllocator = DefaultAllocator>
+class SlabAllocator {
+    static_assert(nodes_per_slab > 0, "a slab must hold at least one node");
+
+public:
+    SlabAllocator() = default;
+
+    // A copy gets a fresh pool of its own, slabs are never shared
+    SlabAllocator(const SlabAllocator& other)
+        : m_backing_allocator(other.m_backing_allocator)
+    {
+    }
+
+    SlabAllocator(SlabAllocator&& other) noexcept
+        : m_backing_allocator(std::move(other.m_backing_allocator))
+        , m_slabs(std::exchange(other.m_slabs, nullptr))
+        , m_free_list(std::exchange(other.m_free_list, nullptr))
+        , m_bump(std::exchange(other.m_bump, nullptr))
+        , m_bump_end(std::exchange(other.m_bump_end, nullptr))
+        , m_slot_size(std::exchange(other.m_slot_size, 0))
+        , m_slot_alignment(std::exchange(other.m_slot_alignment, 0))
+    {
+    }
+
+    ~SlabAllocator()
+    {
+        release_slabs();
+    }
+
+    SlabAllocator& operator=(const SlabAllocator&)
+    {
+        return *this;
+    }
+
+    SlabAllocator& operator=(SlabAllocator&& other) noexcept
+    {
+        if (this != &other) {
+            release_slabs();
+            m_backing_allocator = std::move(other.m_backing_allocator);
+            m_slabs = std::exchange(other.m_slabs, nullptr);
+            m_free_list = std::exchange(other.m_free_list, nullptr);
+            m_bump = std::exchange(other.m_bump, nullptr);
+            m_bump_end = std::exchange(other.m_bump_end, nullptr);
+            m_slot_size = std::exchange(other.m_slot_size, 0);
+            m_slot_alignment = std::exchange(other.m_slot_alignment, 0);
+        }
+        return *this;
+    }
+
+    void* allocate(size_t size, size_t alignment)
+    {
+        if (!m_slot_size) {
+            m_slot_alignment = alignment < alignof(FreeSlot) ? alignof(FreeSlot) : alignment;
+            m_slot_size = round_up(size < sizeof(FreeSlot) ? sizeof(FreeSlot) : size, m_slot_alignment);
+        }
+        ASSERT_WITH_MSG(size <= m_slot_size && alignment <= m_slot_alignment, "SlabAllocator serves a single node size");
+
+        if (m_free_list) [[likely]]
+            return std::exchange(m_free_list, m_free_list->m_next);
+
+        if (m_bump == m_bump_end)
+            allocate_slab();
+
+        void* slot = m_bump;
+        m_bump += m_slot_size;
+        return slot;
+    }
+
+    void deallocate(void* ptr, size_t, size_t)
+    {
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        slot->m_next = m_free_list;
+        m_free_list = slot;
+    }
+
+    // Memory handed out by one pool can only go back to that very pool
+    bool operator==(const SlabAllocator& other) const { return this == &other; }
+
+private:
+    struct FreeSlot {
+        FreeSlot* m_next;
+    };
+
+    struct SlabHeader {
+        SlabHeader* m_next;
+    };
+
+    static constexpr size_t round_up(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+
+    size_t slab_header_size() const { return round_up(sizeof(SlabHeader), m_slot_alignment); }
+    size_t slab_size() const { return slab_header_size() + nodes_per_slab * m_slot_size; }
+    size_t slab_alignment() const { return m_slot_alignment < alignof(SlabHeader) ? alignof(SlabHeader) : m_slot_alignment; }
+
+    NEVER_INLINE void allocate_slab()
+    {
+        SlabHeader* slab = static_cast<SlabHeader*>(m_backing_allocator.allocate(slab_size(), slab_alignment()));
+        slab->m_next = m_slabs;
+        m_slabs = slab;
+
+        m_bump = reinterpret_cast<unsigned char*>(slab) + slab_header_size();
+        m_bump_end = m_bump + nodes_per_slab * m_slot_size;
+    }
+
+    void release_slabs()
+    {
+        while (m_slabs) {
+            SlabHeader* next = m_slabs->m_next;
+            m_backing_allocator.deallocate(m_slabs, slab_size(), slab_alignment());
+            m_slabs = next;
+        }
+        m_free_list = nullptr;
+        m_bump = nullptr;
+        m_bump_end = nullptr;
+    }
+
+private:
+    [[no_unique_address]] BackingAllocator m_backing_allocator { };
+    SlabHeader* m_slabs { nullptr };
+    FreeSlot* m_free_list { nullptr };
+    unsigned char* m_bump { nullptr };
+    unsigned char* m_bump_end { nullptr };
+    size_t m_slot_size { 0 };
+    size_t m_slot_alignment { 0 };
+};
+
+}
+
+using TK::SlabAllocator;
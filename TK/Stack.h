@@ -10,7 +10,7 @@ template<typename T, typename Container = Vector<T>>
 class Stack {
 public:
     using ContainerType = Container;
-    using SizeType = unsigned;
+    using SizeType = typename Container::SizeType;
     using ValueType = T;
     using Reference = T&;
     using ConstReference = const T&;
@@ -40,7 +40,7 @@ public:
 
     [[nodiscard]] bool empty() const { return m_container.empty(); }
 
-    unsigned size() const { return m_container.size(); }
+    SizeType size() const { return m_container.size(); }
 
     void push(const T& value) { m_container.push_back(value); }
     void push(T&& value) { m_container.push_back(TK::move(value)); }
@@ -0,0 +1,189 @@
+#include "ThreadPool.h"
+#include "Assertions.h"
+#include <thread>
+
+namespace TK {
+
+struct ThreadPool::Worker {
+    ThreadPool* m_pool;
+    WorkStealingDeque<Task*> m_deque;
+    std::thread m_thread;
+};
+
+namespace {
+
+constexpr int spins_before_sleep = 64;
+
+thread_local void* s_current_worker = nullptr;
+
+// Spreads the victims of concurrent thieves, quality does not matter here
+size_t next_random()
+{
+    thread_local uint64_t state = reinterpret_cast<uintptr_t>(&state) | 1;
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<size_t>(state);
+}
+
+}
+
+ThreadPool::ThreadPool(size_t thread_count)
+{
+    if (thread_count == 0)
+        thread_count = 1;
+
+    // Every deque must exist before any worker starts stealing
+    m_workers.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+        m_workers.push_back(make_own<Worker>());
+        m_workers[i]->m_pool = this;
+    }
+    for (size_t i = 0; i < thread_count; i++) {
+        Worker& worker = *m_workers[i];
+        worker.m_thread = std::thread([this, &worker] { worker_main(worker); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    wait_idle();
+
+    m_stopping.store(true, std::memory_order_release);
+    m_wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    m_wake_epoch.notify_all();
+
+    for (auto& worker : m_workers)
+        worker->m_thread.join();
+}
+
+size_t ThreadPool::default_thread_count()
+{
+    size_t count = std::thread::hardware_concurrency();
+    return count ? count : 1;
+}
+
+void ThreadPool::submit(Function<void()> function)
+{
+    m_pending.fetch_add(1, std::memory_order_relaxed);
+    push_task(new Task { TK::move(function) });
+}
+
+void ThreadPool::wait_idle()
+{
+    ASSERT_WITH_MSG(!current_worker(), "wait_idle() would wait for the task calling it");
+
+    size_t pending = m_pending.load(std::memory_order_acquire);
+    while (pending) {
+        m_pending.wait(pending, std::memory_order_acquire);
+        pending = m_pending.load(std::memory_order_acquire);
+    }
+}
+
+void ThreadPool::help_until_zero(const std::atomic<size_t>& counter)
+{
+    // A thread outside the pool has no deque of its own to run its subtree from, it would take the oldest injected tasks,
+    // whose waits take the next oldest ones, and nest deeper on its stack with every task, so it leaves the work to the workers
+    Worker* self = current_worker();
+    while (counter.load(std::memory_order_acquire)) {
+        if (!self || !run_one_task(self))
+            std::this_thread::yield();
+    }
+}
+
+ThreadPool::Worker* ThreadPool::current_worker() const
+{
+    auto* worker = static_cast<Worker*>(s_current_worker);
+    return worker && worker->m_pool == this ? worker : nullptr;
+}
+
+void ThreadPool::push_task(Task* task)
+{
+    if (Worker* self = current_worker()) {
+        self->m_deque.push(task);
+    } else {
+        std::lock_guard<std::mutex> guard(m_injection_lock);
+        m_injection_queue.push_back(task);
+        m_injection_size.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Bumping the epoch unconditionally closes the race with a worker about to fall asleep, see `worker_main()`
+    m_wake_epoch.fetch_add(1, std::memory_order_seq_cst);
+    if (m_sleepers.load(std::memory_order_seq_cst))
+        m_wake_epoch.notify_one();
+}
+
+ThreadPool::Task* ThreadPool::find_task(Worker* self)
+{
+    Task* task = nullptr;
+    if (self && self->m_deque.pop(task))
+        return task;
+
+    if (m_injection_size.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> guard(m_injection_lock);
+        if (!m_injection_queue.empty()) {
+            task = m_injection_queue.front();
+            m_injection_queue.pop_front();
+            m_injection_size.fetch_sub(1, std::memory_order_relaxed);
+            return task;
+        }
+    }
+
+    size_t count = m_workers.size();
+    size_t start = next_random() % count;
+    for (size_t i = 0; i < count; i++) {
+        Worker& victim = *m_workers[(start + i) % count];
+        if (&victim != self && victim.m_deque.steal(task))
+            return task;
+    }
+    return nullptr;
+}
+
+bool ThreadPool::run_one_task(Worker* self)
+{
+    Task* task = find_task(self);
+    if (!task)
+        return false;
+    run_task(task);
+    return true;
+}
+
+void ThreadPool::run_task(Task* task)
+{
+    task->m_function();
+    delete task;
+
+    if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        m_pending.notify_all();
+}
+
+void ThreadPool::worker_main(Worker& self)
+{
+    s_current_worker = &self;
+
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        bool found = false;
+        for (int i = 0; i < spins_before_sleep && !found; i++) {
+            found = run_one_task(&self);
+            if (!found && i)
+                std::this_thread::yield();
+        }
+        if (found)
+            continue;
+
+        // A submission either sees this worker among the sleepers and wakes it, or bumps the epoch before `wait()` compares it
+        uint32_t epoch = m_wake_epoch.load(std::memory_order_seq_cst);
+        m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+        if (run_one_task(&self)) {
+            m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+            continue;
+        }
+        if (!m_stopping.load(std::memory_order_acquire))
+            m_wake_epoch.wait(epoch, std::memory_order_seq_cst);
+        m_sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    s_current_worker = nullptr;
+}
+
+}
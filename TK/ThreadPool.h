@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Definitions.h"
+#include "Function.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "ObjectPool.h"
+#include "OwnPtr.h"
+#include "RingBuffer.h"
+#include "Utility.h"
+#include "Vector.h"
+#include "WorkStealingDeque.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <type_traits>
+
+namespace TK {
+
+namespace Internal {
+
+// Pooled, so that once the pool warmed up a submission takes its task from the thread's cache rather than the heap
+struct ThreadPoolTask {
+    TK_MAKE_POOLED(ThreadPoolTask)
+
+    Function<void()> m_function;
+};
+
+} // namespace Internal
+
+/* Work Stealing Thread Pool */
+// Every worker has a deque of its own: tasks it submits go to the bottom of it and it runs them newest first, which keeps their data warm,
+// while idle workers steal the oldest tasks from the top of the others' deques, which tend to be the largest pieces of work
+// Tasks submitted by threads outside the pool go through a shared injection queue instead
+// Workers spin briefly when they run out of work, then sleep until the next submission
+class ThreadPool {
+    TK_MAKE_NONCOPYABLE(ThreadPool)
+    TK_MAKE_NONMOVABLE(ThreadPool)
+
+public:
+    explicit ThreadPool(size_t thread_count = default_thread_count());
+
+    // Runs every task submitted so far before the workers stop
+    ~ThreadPool();
+
+    static size_t default_thread_count();
+
+    [[nodiscard]] size_t thread_count() const { return m_workers.size(); }
+
+    void submit(Function<void()> function);
+
+    // Calls `body(first, last)` over chunks of at most `grain` indices, or `body(index)` for each index if it takes a single one
+    // The range is split in halves as a tree of tasks, so that thieves take large pieces
+    // A worker calling it runs tasks too until it is done, any other thread runs the first chunk and yields to the workers for the rest
+    // May be nested, a task running on the pool can call it again
+    template<typename Body>
+    void parallel_for(size_t begin, size_t end, size_t grain, Body&& body)
+    {
+        if (begin >= end)
+            return;
+
+        ParallelFor<std::remove_reference_t<Body>> state { body, grain ? grain : 1, end - begin };
+        run_range(&state, begin, end);
+        help_until_zero(state.m_remaining);
+    }
+
+    // Blocks until every submitted task has run, must not be called from a task of this pool
+    void wait_idle();
+
+private:
+    using Task = Internal::ThreadPoolTask;
+    struct Worker;
+
+    template<typename Body>
+    struct ParallelFor {
+        Body& m_body;
+        size_t m_grain;
+        std::atomic<size_t> m_remaining;
+    };
+
+    template<typename Body>
+    void run_range(ParallelFor<Body>* state, size_t first, size_t last)
+    {
+        while (last - first > state->m_grain) {
+            size_t middle = first + (last - first) / 2;
+            submit([this, state, middle, last] { run_range(state, middle, last); });
+            last = middle;
+        }
+
+        if constexpr (std::is_invocable<Body&, size_t, size_t>::value) {
+            state->m_body(first, last);
+        } else {
+            for (size_t index = first; index < last; index++)
+                state->m_body(index);
+        }
+
+        // The caller may return as soon as this reaches zero, `state` must not be touched afterwards
+        state->m_remaining.fetch_sub(last - first, std::memory_order_release);
+    }
+
+    // Runs whatever tasks it finds while waiting, so that waiting inside a task does not starve the pool
+    void help_until_zero(const std::atomic<size_t>& counter);
+
+    Worker* current_worker() const;
+    void push_task(Task* task);
+    Task* find_task(Worker* self);
+    bool run_one_task(Worker* self);
+    void run_task(Task* task);
+    void worker_main(Worker& self);
+
+private:
+    Vector<OwnPtr<Worker>> m_workers { };
+
+    std::mutex m_injection_lock;
+    RingBuffer<Task*> m_injection_queue { };
+    std::atomic<size_t> m_injection_size { 0 };
+
+    std::atomic<size_t> m_pending { 0 };
+    std::atomic<uint32_t> m_wake_epoch { 0 };
+    std::atomic<size_t> m_sleepers { 0 };
+    std::atomic<bool> m_stopping { false };
+};
+
+}
+
+using TK::ThreadPool;
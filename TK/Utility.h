@@ -1,5 +1,7 @@
 #pragma once
 
+#include <type_traits>
+
 namespace TK {
 
 template<typename T> struct is_lvalue_reference      { static constexpr bool value = false; };
@@ -20,16 +22,16 @@ constexpr typename remove_reference<T>::type&& move(T&& arg) noexcept
 template<typename T>
 void swap(T& a, T& b)
 {
-    T t = move(a);
-    a = move(b);
-    b = move(t);
+    T t = TK::move(a);
+    a = TK::move(b);
+    b = TK::move(t);
 }
 
-// template<typename T>
-// constexpr T&& forward(typename remove_reference<T>::type& arg) noexcept
-// {
-//     return static_cast<T&&>(arg);
-// }
+template<typename T>
+constexpr T&& forward(typename remove_reference<T>::type& arg) noexcept
+{
+    return static_cast<T&&>(arg);
+}
 
 template<typename T>
 constexpr T&& forward(typename remove_reference<T>::type&& arg) noexcept
@@ -38,4 +40,8 @@ constexpr T&& forward(typename remove_reference<T>::type&& arg) noexcept
     return static_cast<T&&>(arg);
 }
 
+// Whether an object can be moved to a new address with a plain byte copy, leaving nothing to destroy behind
+// Specialize it for types which are not trivially copyable but still safe to relocate bytewise
+template<typename T> struct is_trivially_relocatable { static constexpr bool value = std::is_trivially_copyable<T>::value; };
+
 } // namespace TK
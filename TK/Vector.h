@@ -1,88 +1,133 @@
 #pragma once
 
+#include "Allocator.h"
+#include "Assertions.h"
 #include "Iterator.h"
+#include "SIMD.h"
 #include "Utility.h"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
 #include <new>
 #include <initializer_list>
+#include <type_traits>
 
 namespace ToolKit {
 
-template <typename T>
+/* Vector Growth Policies */
+
+// Doubles the capacity, amortized O(1) appending at the cost of up to 2x memory overhead
+struct DoublingGrowth {
+    template<typename SizeType>
+    static constexpr SizeType next_capacity(SizeType capacity) { return capacity == 0 ? 1 : 2 * capacity; }
+};
+
+// Grows the capacity by half, trades a few more reallocations for less slack memory
+struct OneAndHalfGrowth {
+    template<typename SizeType>
+    static constexpr SizeType next_capacity(SizeType capacity) { return capacity < 2 ? capacity + 1 : capacity + capacity / 2; }
+};
+
+// Grows the capacity by a fixed number of elements, for buffers whose final size is roughly known
+template<size_t step>
+struct FixedStepGrowth {
+    static_assert(step > 0, "growth step must be positive");
+
+    template<typename SizeType>
+    static constexpr SizeType next_capacity(SizeType capacity) { return capacity + step; }
+};
+
+namespace Internal {
+
+// Uninitialized storage for the elements a `Vector` keeps inline
+template<typename T, size_t capacity>
+struct VectorInlineBuffer {
+    T* data() noexcept { return reinterpret_cast<T*>(m_storage); }
+    const T* data() const noexcept { return reinterpret_cast<const T*>(m_storage); }
+
+    alignas(T) unsigned char m_storage[capacity * sizeof(T)];
+};
+
+template<typename T>
+struct VectorInlineBuffer<T, 0> {
+    T* data() noexcept { return nullptr; }
+    const T* data() const noexcept { return nullptr; }
+};
+
+} // namespace Internal
+
+// `Size` can be narrowed to a 32-bit type when cache density matters more than capacity
+// The first `inline_capacity` elements live inside the `Vector` itself and spill to the heap once it grows past them
+// Heap storage comes from `Allocator`, which lets a `Vector` draw from an `Arena` through `ArenaAllocator`
+template <typename T, typename GrowthPolicy = DoublingGrowth, typename Size = size_t, size_t inline_capacity = 0, typename Allocator = TK::DefaultAllocator>
 class Vector {
+    static_assert(std::is_unsigned<Size>::value, "Vector size type must be an unsigned integer");
+    static_assert(inline_capacity <= static_cast<Size>(-1), "Vector inline capacity does not fit in its size type");
+
 public:
-    using SizeType       = unsigned;
+    using SizeType       = Size;
     using ValueType      = T;
     using Reference      = ValueType&;
     using ConstReference = const ValueType&;
     using Pointer        = ValueType*;
     using ConstPointer   = const ValueType*;
-    using VectorIterator = Iterator<Vector<ValueType>, ValueType>;
+    using VectorIterator = Iterator<Vector, ValueType>;
 
 public:
     Vector() = default;
 
+    constexpr explicit Vector(const Allocator& allocator)
+        : m_allocator (allocator)
+    {
+    }
+
     constexpr Vector(const Vector& other)
-        : m_data (static_cast<T*>(::operator new(sizeof(T) * other.m_capacity)))
-        , m_size (other.m_size)
-        , m_capacity (other.m_capacity)
+        : m_allocator (other.m_allocator)
     {
-        for (unsigned i = 0; i < m_size; i++)
-            new(&m_data[i]) T(other.m_data[i]);
+        reserve(other.m_size);
+        copy_construct(m_data, other.m_data, other.m_size);
+        m_size = other.m_size;
     }
 
     constexpr Vector(Vector&& other) noexcept
-        : m_data (other.m_data)
-        , m_size (other.m_size)
-        , m_capacity (other.m_capacity)
+        : m_allocator (TK::move(other.m_allocator))
     {
-        other.m_data = nullptr;
-        other.m_size = 0;
-        other.m_capacity = 0;
+        steal_from(TK::move(other));
     }
 
     constexpr Vector(std::initializer_list<T> init_list)
     {
-        reserve(init_list.size());
+        reserve(checked_size(init_list.size()));
         for (auto& obj: init_list)
             push_back(obj);
     }
 
-    constexpr explicit Vector(unsigned size)
+    constexpr explicit Vector(SizeType size)
     {
+        reserve(size);
+        fill_construct(m_data, size, T());
         m_size = size;
-        m_capacity = size;
-        m_data = static_cast<T*>(::operator new(sizeof(T) * m_capacity));
-        for (unsigned i = 0; i < m_size; i++)
-            new(&m_data[i]) T();
     }
 
-    constexpr Vector(unsigned size, const T& value)
+    constexpr Vector(SizeType size, const T& value)
     {
+        reserve(size);
+        fill_construct(m_data, size, value);
         m_size = size;
-        m_capacity = size;
-        m_data = static_cast<T*>(::operator new(sizeof(T) * m_capacity));
-        for (unsigned i = 0; i < m_size; i++)
-            new(&m_data[i]) T(value);
     }
 
     constexpr Vector(const VectorIterator begin, const VectorIterator end)
     {
-        m_size = end - begin;
-        m_capacity = m_size;
-        m_data = static_cast<T*>(::operator new(sizeof(T) * m_capacity));
-        for (unsigned i = 0; i < m_size; i++)
-            new(&m_data[i]) T(*(begin + i));
+        SizeType size = checked_size(end - begin);
+        reserve(size);
+        copy_construct(m_data, begin.m_ptr, size);
+        m_size = size;
     }
 
     ~Vector()
     {
-        if (m_data) {
-            for (unsigned i = 0; i < m_size; i++)
-                m_data[i].~T();
-            ::operator delete(m_data);
-        }
-        m_size = 0;
-        m_capacity = 0;
+        clear();
+        release_storage();
     }
 
     constexpr Vector& operator=(const Vector& other)
@@ -90,20 +135,16 @@ public:
        if (&other == this)
            return *this;
 
-       if (m_data) {
-           for (unsigned i = 0; i < m_size; i++)
-               m_data[i].~T();
-       }
+       clear();
 
        /* if the LHS vector cannot contain the RHS vector, reallocate enough memory */
        if (m_capacity < other.m_size) {
-           ::operator delete(m_data);
-           m_data = static_cast<T*>(::operator new(sizeof(T) * other.m_size));
+           release_storage();
+           m_data = allocate(other.m_size);
            m_capacity = other.m_size;
        }
 
-       for (unsigned i = 0; i < other.m_size; i++)
-           new(&m_data[i]) T(other.m_data[i]);
+       copy_construct(m_data, other.m_data, other.m_size);
 
        m_size = other.m_size;
 
@@ -115,34 +156,24 @@ public:
         if (&other == this)
             return *this;
 
-        if (m_data) {
-            for (unsigned i = 0; i < m_size; i++)
-                m_data[i].~T();
-            ::operator delete(m_data);
-        }
-
-        m_data = other.m_data;
-        m_size = other.m_size;
-        m_capacity = other.m_capacity;
+        clear();
+        release_storage();
 
-        other.m_data = nullptr;
-        other.m_size = 0;
-        other.m_capacity = 0;
+        // The storage of `other` must keep going back to the allocator it came from
+        TK::swap(m_allocator, other.m_allocator);
+        steal_from(TK::move(other));
 
         return *this;
     }
 
     constexpr Vector& operator=(std::initializer_list<T> init_list)
     {
-        if (m_data) {
-            for (unsigned i = 0; i < m_size; i++)
-                m_data[i].~T();
-        }
+        clear();
 
         if (m_capacity < init_list.size()) {
-            ::operator delete(m_data);
-            m_data = static_cast<T*>(::operator new(sizeof(T) * init_list.size()));
-            m_capacity = init_list.size();
+            release_storage();
+            m_capacity = checked_size(init_list.size());
+            m_data = allocate(m_capacity);
         }
 
         for(auto& obj: init_list)
@@ -151,18 +182,40 @@ public:
         return *this;
     }
 
-    bool operator==(const Vector& other) = delete;
-    bool operator!=(const Vector& other) = delete;
+    // Integer and floating point elements are compared by the SIMD kernels, anything else one by one
+    [[nodiscard]] bool operator==(const Vector& other) const
+    {
+        if (m_size != other.m_size)
+            return false;
+
+        if constexpr (TK::SIMD::is_vectorizable<T>) {
+            return TK::SIMD::equal(m_data, other.m_data, m_size);
+        } else {
+            for (SizeType i = 0; i < m_size; i++) {
+                if (!(m_data[i] == other.m_data[i]))
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    [[nodiscard]] bool operator!=(const Vector& other) const { return !(*this == other); }
+
     bool operator>(const Vector& other) = delete;
     bool operator<(const Vector& other) = delete;
     bool operator>=(const Vector& other) = delete;
     bool operator<=(const Vector& other) = delete;
 
-    [[nodiscard]] constexpr T& operator[](unsigned index) noexcept { return m_data[index]; }
-    [[nodiscard]] constexpr const T& operator[](unsigned index) const noexcept { return m_data[index]; }
+    [[nodiscard]] constexpr T& operator[](SizeType index) noexcept { return m_data[index]; }
+    [[nodiscard]] constexpr const T& operator[](SizeType index) const noexcept { return m_data[index]; }
 
-    [[nodiscard]] constexpr unsigned capacity() const noexcept { return m_capacity; }
-    [[nodiscard]] constexpr unsigned size() const noexcept { return m_size; }
+    [[nodiscard]] constexpr SizeType capacity() const noexcept { return m_capacity; }
+    [[nodiscard]] static constexpr SizeType max_size() noexcept
+    {
+        constexpr size_t max_count = static_cast<size_t>(-1) / sizeof(T);
+        return static_cast<SizeType>(-1) < max_count ? static_cast<SizeType>(-1) : static_cast<SizeType>(max_count);
+    }
+    [[nodiscard]] constexpr SizeType size() const noexcept { return m_size; }
     [[nodiscard]] constexpr bool empty() const noexcept { return m_size == 0; }
 
     [[nodiscard]] constexpr VectorIterator begin() noexcept { return VectorIterator(m_data); }
@@ -175,7 +228,7 @@ public:
     [[nodiscard]] constexpr const VectorIterator crbegin() const noexcept { }
     [[nodiscard]] constexpr const VectorIterator crend() const noexcept { }
 
-    constexpr T& at(unsigned idx)
+    constexpr T& at(SizeType idx)
     {
         // TODO: Cup internal out of range error
         if (idx >= m_size)
@@ -184,7 +237,7 @@ public:
         return m_data[idx];
     }
 
-    constexpr const T& at(unsigned idx) const
+    constexpr const T& at(SizeType idx) const
     {
         // TODO: Cup internal out of range error
         if (idx >= m_size)
@@ -199,9 +252,18 @@ public:
     [[nodiscard]] constexpr T& back() { return m_data[m_size - 1]; }
     [[nodiscard]] constexpr const T& back() const { return m_data[m_size - 1]; }
 
+    // The first element equal to `value`, or `end()`
+    [[nodiscard]] VectorIterator find(const T& value) { return VectorIterator(m_data + index_of_value(value)); }
+    [[nodiscard]] const VectorIterator find(const T& value) const { return VectorIterator(m_data + index_of_value(value)); }
+
+    [[nodiscard]] bool contains(const T& value) const { return index_of_value(value) != m_size; }
+
     [[nodiscard]] constexpr T* data() noexcept { return m_data; }
     [[nodiscard]] constexpr const T* data() const noexcept { return m_data; }
 
+    // Whether the elements currently live in the inline buffer rather than on the heap
+    [[nodiscard]] constexpr bool is_inline() const noexcept { return inline_capacity > 0 && m_data == m_inline_buffer.data(); }
+
     // @ref: https://en.cppreference.com/w/cpp/container/vector/insert (1)
     constexpr void insert(const VectorIterator pos, const T& value)
     {
@@ -211,53 +273,114 @@ public:
     // @ref: https://en.cppreference.com/w/cpp/container/vector/insert (2)
     constexpr void insert(const VectorIterator pos, T&& value)
     {
-        emplace(pos, move(value));
+        emplace(pos, TK::move(value));
     }
 
     // @ref: https://en.cppreference.com/w/cpp/container/vector/insert (3)
-    constexpr void insert(const VectorIterator pos, unsigned count, const T& value)
+    constexpr void insert(const VectorIterator pos, SizeType count, const T& value)
     {
-        for (unsigned i = 0; i < count; i++)
-            emplace(pos, value);
+        if (count == 0)
+            return;
+
+        // `value` may be one of our own elements, which opening the gap would move away
+        if (contains_address(&value)) {
+            T copy { value };
+            insert(pos, count, copy);
+            return;
+        }
+
+        SizeType index = index_of(pos);
+        open_gap(index, count);
+        fill_construct(m_data + index, count, value);
     }
 
     // @ref: https://en.cppreference.com/w/cpp/container/vector/insert (4)
     constexpr void insert(const VectorIterator pos, const VectorIterator first, const VectorIterator last)
     {
-        for (auto it = first; it != last; it++)
-            emplace(pos, *it);
+        if (first == last)
+            return;
+
+        // The range may come from this very vector, which opening the gap would move away
+        if (contains_address(first.m_ptr)) {
+            Vector copy(m_allocator);
+            copy.insert(copy.end(), first, last);
+            insert(pos, copy.begin(), copy.end());
+            return;
+        }
+
+        SizeType index = index_of(pos);
+        SizeType count = checked_size(last - first);
+        open_gap(index, count);
+        copy_construct(m_data + index, first.m_ptr, count);
     }
 
     // @ref: https://en.cppreference.com/w/cpp/container/vector/insert (5)
     constexpr void insert(const VectorIterator pos, std::initializer_list<T> init_list)
     {
-        for (auto it = init_list.begin(); it != init_list.end(); it++)
-            emplace(pos, *it);
+        SizeType index = index_of(pos);
+        SizeType count = checked_size(init_list.size());
+        open_gap(index, count);
+        for (SizeType i = 0; i < count; i++)
+            new(&m_data[index + i]) T(init_list.begin()[i]);
     }
 
     // @ref: https://en.cppreference.com/w/cpp/container/vector/emplace
     template<typename... Args>
     constexpr void emplace(const VectorIterator pos, Args&&... args)
     {
+        SizeType index = index_of(pos);
+
+        // Construct the element first, the arguments may refer to elements which are about to be shifted
+        T value(TK::forward<Args>(args)...);
+        open_gap(index, 1);
+        new(&m_data[index]) T(TK::move(value));
     }
 
     // @ref: https://en.cppreference.com/w/cpp/container/vector/erase (1)
     // erase pos
     constexpr void erase(const VectorIterator pos)
     {
+        erase(pos, pos + 1);
     }
 
     // @ref: https://en.cppreference.com/w/cpp/container/vector/erase (2)
     // erase [first, last)
     constexpr void erase(const VectorIterator first, const VectorIterator last)
     {
+        if (first == last)
+            return;
+
+        SizeType index = index_of(first);
+        SizeType count = index_of(last) - index;
+        ASSERT(index + count <= m_size);
+
+        if constexpr (relocates_bytewise) {
+            // Relocatable does not mean trivially destructible, the erased elements may still own something
+            destroy(m_data + index, count);
+            std::memmove(static_cast<void*>(m_data + index), static_cast<const void*>(m_data + index + count), (m_size - index - count) * sizeof(T));
+        } else {
+            for (SizeType i = index; i + count < m_size; i++)
+                m_data[i] = TK::move(m_data[i + count]);
+            destroy(m_data + m_size - count, count);
+        }
+
+        m_size -= count;
     }
 
     constexpr void swap(Vector& other) noexcept
     {
-        swap(m_data, other.m_data);
-        swap(m_size, other.m_size);
-        swap(m_capacity, other.m_capacity);
+        // Inline elements cannot change hands by swapping pointers
+        if (is_inline() || other.is_inline()) {
+            Vector temp { TK::move(other) };
+            other = TK::move(*this);
+            *this = TK::move(temp);
+            return;
+        }
+
+        TK::swap(m_allocator, other.m_allocator);
+        TK::swap(m_data, other.m_data);
+        TK::swap(m_size, other.m_size);
+        TK::swap(m_capacity, other.m_capacity);
     }
 
     template<typename F>
@@ -273,11 +396,11 @@ public:
         if (m_size >= m_capacity)
             realloc(new_capacity());
 
-        new(&m_data[m_size++]) T(forward<Args>(args)...);
+        new(&m_data[m_size++]) T(TK::forward<Args>(args)...);
     }
 
     constexpr void push_back(const T& value) { emplace_back(value); }
-    constexpr void push_back(T&& value) { emplace_back(move(value)); }
+    constexpr void push_back(T&& value) { emplace_back(TK::move(value)); }
 
     constexpr void pop_back()
     {
@@ -285,70 +408,283 @@ public:
             m_data[--m_size].~T();
     }
 
-    constexpr void reserve(unsigned new_capacity)
+    constexpr void reserve(SizeType new_capacity)
     {
         if (new_capacity > m_capacity)
             realloc(new_capacity);
     }
 
-    constexpr void resize(unsigned new_size)
+    constexpr void resize(SizeType new_size)
     {
         if (m_size > new_size) {
-            for (unsigned i = new_size; i < m_size; i++)
-                m_data[i].~T();
+            destroy(m_data + new_size, m_size - new_size);
+            m_size = new_size;
         }
 
         if (m_size < new_size) {
-            for (unsigned i = 0; i < new_size - m_size; i++)
-                push_back(T());
+            reserve(new_size);
+            fill_construct(m_data + m_size, new_size - m_size, T());
+            m_size = new_size;
         }
     }
 
-    constexpr void resize(unsigned new_size, const T& value)
+    constexpr void resize(SizeType new_size, const T& value)
     {
+        if (m_size >= new_size) {
+            resize(new_size);
+            return;
+        }
+
+        // `value` may be one of our own elements, which growing the storage would move away
+        if (contains_address(&value) && new_size > m_capacity) {
+            T copy { value };
+            resize(new_size, copy);
+            return;
+        }
+
+        reserve(new_size);
+        fill_construct(m_data + m_size, new_size - m_size, value);
+        m_size = new_size;
     }
 
     constexpr void clear() noexcept
     {
-        if (m_data) {
-            for (unsigned i = 0; i < m_size; i++)
-                m_data[i].~T();
-            m_size = 0;
-        }
+        destroy(m_data, m_size);
+        m_size = 0;
     }
 
 private:
-    constexpr unsigned new_capacity()
+    // Trivially relocatable elements can be moved around bytewise
+    static constexpr bool relocates_bytewise = TK::is_trivially_relocatable<T>::value && alignof(T) <= alignof(std::max_align_t);
+
+    // With the default allocator, such elements get their storage from `malloc` and grow it with `realloc`,
+    // which extends the block in place when possible (and remaps the pages of large blocks)
+    static constexpr bool uses_malloc = relocates_bytewise && std::is_same<Allocator, TK::DefaultAllocator>::value;
+
+    static constexpr SizeType checked_size(size_t count)
     {
-        return m_capacity == 0 ? 1 : 2 * m_capacity;
+        VERIFY_WITH_MSG(count <= max_size(), "Vector cannot hold %zu elements", count);
+        return static_cast<SizeType>(count);
     }
 
-    constexpr void realloc(unsigned new_capacity)
+    static constexpr size_t allocation_size(SizeType capacity)
     {
-        T* new_data = static_cast<T*>(::operator new(sizeof(T) * new_capacity));
+        size_t bytes = 0;
+        VERIFY_WITH_MSG(!__builtin_mul_overflow(sizeof(T), capacity, &bytes), "Vector capacity overflow");
+        return bytes;
+    }
 
-        if (new_capacity < m_size)
+    T* allocate(SizeType capacity)
+    {
+        if constexpr (uses_malloc) {
+            T* data = static_cast<T*>(std::malloc(allocation_size(capacity)));
+            ASSERT(data || capacity == 0);
+            return data;
+        } else {
+            return static_cast<T*>(m_allocator.allocate(allocation_size(capacity), alignof(T)));
+        }
+    }
+
+    void deallocate(T* data, SizeType capacity)
+    {
+        if constexpr (uses_malloc)
+            std::free(data);
+        else if (data)
+            m_allocator.deallocate(data, allocation_size(capacity), alignof(T));
+    }
+
+    constexpr SizeType new_capacity()
+    {
+        VERIFY_WITH_MSG(m_capacity < max_size(), "Vector cannot grow any further");
+
+        // Clamp to the maximum size when the policy would overflow it
+        SizeType capacity = GrowthPolicy::next_capacity(m_capacity);
+        if (capacity <= m_capacity || capacity > max_size())
+            capacity = max_size();
+        return capacity;
+    }
+
+    constexpr void realloc(SizeType new_capacity)
+    {
+        if (new_capacity < m_size) {
+            destroy(m_data + new_capacity, m_size - new_capacity);
             m_size = new_capacity;
+        }
 
-        if (m_data) {
-            for (unsigned i = 0; i < m_size; i++)
-                new(&new_data[i]) T(move(m_data[i]));
+        // The inline buffer never shrinks and never moves into another inline buffer
+        if (is_inline() && new_capacity <= inline_capacity)
+            return;
+
+        if constexpr (uses_malloc) {
+            if (!is_inline()) {
+                T* new_data = static_cast<T*>(std::realloc(static_cast<void*>(m_data), allocation_size(new_capacity)));
+                ASSERT(new_data || new_capacity == 0);
+                m_data = new_data;
+                m_capacity = new_capacity;
+                return;
+            }
+        }
+
+        T* new_data = allocate(new_capacity);
 
-            for (unsigned i = 0; i < m_size; i++)
-                m_data[i].~T();
-            ::operator delete(m_data);
+        if (m_data) {
+            if constexpr (relocates_bytewise) {
+                if (m_size > 0)
+                    std::memcpy(static_cast<void*>(new_data), static_cast<const void*>(m_data), m_size * sizeof(T));
+            } else {
+                for (SizeType i = 0; i < m_size; i++)
+                    new(&new_data[i]) T(TK::move(m_data[i]));
+
+                for (SizeType i = 0; i < m_size; i++)
+                    m_data[i].~T();
+            }
+            release_storage();
         }
 
         m_data = new_data;
         m_capacity = new_capacity;
     }
 
+    constexpr SizeType index_of(const VectorIterator it) const
+    {
+        ASSERT(it.m_ptr >= m_data && it.m_ptr <= m_data + m_size);
+        return static_cast<SizeType>(it.m_ptr - m_data);
+    }
+
+    SizeType index_of_value(const T& value) const
+    {
+        if constexpr (TK::SIMD::is_vectorizable<T>) {
+            return static_cast<SizeType>(TK::SIMD::find(m_data, static_cast<size_t>(m_size), value));
+        } else {
+            SizeType index = 0;
+            while (index < m_size && !(m_data[index] == value))
+                index++;
+            return index;
+        }
+    }
+
+    constexpr bool contains_address(const T* ptr) const
+    {
+        return m_size > 0 && ptr >= m_data && ptr < m_data + m_size;
+    }
+
+    /* Bulk Construction and Destruction */
+    // Element by element in general, but trivially copyable elements are copied with `memcpy`,
+    // fills go through the SIMD kernels or `memset`, and trivially destructible elements are not destroyed at all
+
+    static void copy_construct(T* destination, const T* source, SizeType count)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value) {
+            if (count > 0)
+                std::memcpy(destination, source, count * sizeof(T));
+        } else {
+            for (SizeType i = 0; i < count; i++)
+                new(&destination[i]) T(source[i]);
+        }
+    }
+
+    static void fill_construct(T* destination, SizeType count, const T& value)
+    {
+        if constexpr (TK::SIMD::is_vectorizable<T>) {
+            TK::SIMD::fill(destination, static_cast<size_t>(count), value);
+            return;
+        } else if constexpr (std::is_trivially_copyable<T>::value) {
+            // Zero is by far the most common fill, value initialized elements above all
+            unsigned char bytes[sizeof(T)];
+            std::memcpy(bytes, &value, sizeof(T));
+            bool is_zero = true;
+            for (size_t i = 0; i < sizeof(T); i++)
+                is_zero &= bytes[i] == 0;
+
+            if (is_zero) {
+                if (count > 0)
+                    std::memset(static_cast<void*>(destination), 0, count * sizeof(T));
+                return;
+            }
+        }
+
+        for (SizeType i = 0; i < count; i++)
+            new(&destination[i]) T(value);
+    }
+
+    static constexpr void destroy(T* data, SizeType count) noexcept
+    {
+        if constexpr (!std::is_trivially_destructible<T>::value) {
+            for (SizeType i = 0; i < count; i++)
+                data[i].~T();
+        }
+    }
+
+    // Makes room for `count` elements at `index` by shifting the tail in one pass, the gap is left uninitialized
+    constexpr void open_gap(SizeType index, SizeType count)
+    {
+        ASSERT(index <= m_size);
+        VERIFY_WITH_MSG(count <= max_size() - m_size, "Vector cannot hold that many elements");
+
+        if (m_size + count > m_capacity) {
+            SizeType capacity = new_capacity();
+            realloc(capacity < m_size + count ? m_size + count : capacity);
+        }
+
+        if constexpr (relocates_bytewise) {
+            std::memmove(static_cast<void*>(m_data + index + count), static_cast<const void*>(m_data + index), (m_size - index) * sizeof(T));
+        } else {
+            for (SizeType i = m_size; i > index; i--) {
+                new(&m_data[i - 1 + count]) T(TK::move(m_data[i - 1]));
+                m_data[i - 1].~T();
+            }
+        }
+
+        m_size += count;
+    }
+
+    // Frees the heap storage if any, falling back to the inline buffer, the elements must be destroyed already
+    constexpr void release_storage() noexcept
+    {
+        if (!is_inline())
+            deallocate(m_data, m_capacity);
+        m_data = m_inline_buffer.data();
+        m_capacity = inline_capacity;
+    }
+
+    // Takes over the elements of `other`, leaving it empty, this vector must have no storage of its own
+    constexpr void steal_from(Vector&& other) noexcept
+    {
+        if (other.is_inline()) {
+            for (SizeType i = 0; i < other.m_size; i++) {
+                new(&m_data[i]) T(TK::move(other.m_data[i]));
+                other.m_data[i].~T();
+            }
+            m_size = other.m_size;
+            other.m_size = 0;
+            return;
+        }
+
+        m_data = other.m_data;
+        m_size = other.m_size;
+        m_capacity = other.m_capacity;
+
+        other.m_data = other.m_inline_buffer.data();
+        other.m_size = 0;
+        other.m_capacity = inline_capacity;
+    }
+
 private:
-    T* m_data { nullptr };
-    unsigned m_size { 0 };
-    unsigned m_capacity { 0 };
+    [[no_unique_address]] Allocator m_allocator { };
+    [[no_unique_address]] Internal::VectorInlineBuffer<T, inline_capacity> m_inline_buffer;
+    T* m_data { m_inline_buffer.data() };
+    SizeType m_size { 0 };
+    SizeType m_capacity { inline_capacity };
 };
 
+// Vector keeping its first `inline_capacity` elements inline, without touching the heap until it grows past them
+template<typename T, size_t inline_capacity>
+using SmallVector = Vector<T, DoublingGrowth, size_t, inline_capacity>;
+
 }
 
 using ToolKit::Vector;
+using ToolKit::SmallVector;
+using ToolKit::DoublingGrowth;
+using ToolKit::OneAndHalfGrowth;
+using ToolKit::FixedStepGrowth;
@@ -104,8 +104,17 @@ public:
 
     RefPtr<T> strong_ref() const
     {
-        ASSERT(ptr());
-        return RefPtr<T> { ptr() };
+        RefPtr<T> ref = try_strong_ref();
+        ASSERT(ref);
+        return ref;
+    }
+
+    // Safe to call while another thread drops the last strong reference, a null `RefPtr` is returned then
+    RefPtr<T> try_strong_ref() const
+    {
+        if (!m_flag)
+            return nullptr;
+        return m_flag->template try_strong_ref<T>();
     }
 
     unsigned weak_cnt() const { return m_flag ? m_flag->ref_count() : 0; }
@@ -1,8 +1,12 @@
 #pragma once
 
+#include "AtomicRefCounted.h"
 #include "RefCounted.h"
 #include "RefPtr.h"
 #include "NonCopyable.h"
+#include "Utility.h"
+#include <atomic>
+#include <new>
 #include <utility>
 #include <type_traits>
 
@@ -15,13 +19,84 @@ class WeakPtr;
 
 namespace Internal {
 
-class WeakFlag : public RefCounted<WeakFlag> {
+// Shared by an object and all the `WeakPtr`s pointing to it, so it may be used from several threads at once
+// The short lock makes upgrading a `WeakPtr` and invalidating the flag in `~Weakable` mutually exclusive,
+// so that the object cannot be freed while its reference count is being looked at
+class WeakFlag : public AtomicRefCounted<WeakFlag> {
 public:
-    bool is_valid() const { return m_ptr != nullptr; }
-    void invalidate() const { m_ptr = nullptr; }
+    bool is_valid() const { return m_ptr.load(std::memory_order_acquire) != nullptr; }
 
+    void invalidate() const
+    {
+        lock();
+        m_ptr.store(nullptr, std::memory_order_relaxed);
+        unlock();
+    }
+
+    template<typename T>
+    T* unsafe_ptr() const { return static_cast<T*>(m_ptr.load(std::memory_order_acquire)); }
+
+    // Whether the flag shares one allocation with its object, see `make_ref_with_weak()`
+    bool is_fused() const { return m_block_size != 0; }
+
+    // A fused block is freed along with the flag, which outlives the object as long as some `WeakPtr` is left
+    static void operator delete(WeakFlag* flag, std::destroying_delete_t)
+    {
+        size_t block_size = flag->m_block_size;
+        size_t block_alignment = flag->m_block_alignment;
+        flag->~WeakFlag();
+
+        if (block_size)
+            ::operator delete(static_cast<void*>(flag), block_size, std::align_val_t(block_alignment));
+        else
+            ::operator delete(static_cast<void*>(flag), sizeof(WeakFlag));
+    }
+
+    // Lays out the flag and the object in a single cache-line-aligned block, the flag first, then the object
+    template<typename T, typename... Args>
+    static T* make_fused(Args&&... args)
+    {
+        constexpr size_t object_offset = (sizeof(WeakFlag) + alignof(T) - 1) / alignof(T) * alignof(T);
+        constexpr size_t block_size = object_offset + sizeof(T);
+        constexpr size_t block_alignment = alignof(T) > cache_line_size ? alignof(T) : cache_line_size;
+
+        void* block = ::operator new(block_size, std::align_val_t(block_alignment));
+        WeakFlag* flag = new (block) WeakFlag(block_size, block_alignment);
+
+        // Gives the block back should the constructor of `T` throw, nothing refers to the flag yet
+        struct BlockGuard {
+            ~BlockGuard()
+            {
+                if (!m_flag)
+                    return;
+                m_flag->~WeakFlag();
+                ::operator delete(static_cast<void*>(m_flag), block_size, std::align_val_t(block_alignment));
+            }
+
+            WeakFlag* m_flag;
+        } guard { flag };
+
+        T* object = new (static_cast<unsigned char*>(block) + object_offset) T(TK::forward<Args>(args)...);
+        guard.m_flag = nullptr;
+
+        // The object holds the first reference to its flag, as it does when `weak_from_this()` creates one
+        flag->m_ptr.store(object, std::memory_order_relaxed);
+        flag->ref();
+        ASSERT_WITH_MSG(!object->Weakable<T>::m_flag.load(std::memory_order_relaxed), "weak_from_this() called during construction of a fused object");
+        object->Weakable<T>::m_flag.store(flag, std::memory_order_release);
+        return object;
+    }
+
+    // Returns a null `RefPtr` once the last strong reference is gone, even if the object has not been destroyed yet
     template<typename T>
-    T* unsafe_ptr() const { return static_cast<T*>(m_ptr); }
+    RefPtr<T> try_strong_ref() const
+    {
+        lock();
+        T* ptr = static_cast<T*>(m_ptr.load(std::memory_order_relaxed));
+        bool referenced = ptr && ptr->try_ref();
+        unlock();
+        return adopt_ref_if_nonnull(referenced ? ptr : nullptr);
+    }
 
 private:
     template<typename T>
@@ -36,22 +111,61 @@ private:
     {
     }
 
-    mutable void* m_ptr { nullptr };
+    WeakFlag(size_t block_size, size_t block_alignment)
+        : m_block_size(block_size)
+        , m_block_alignment(block_alignment)
+    {
+    }
+
+    static constexpr size_t cache_line_size = 64;
+
+    void lock() const
+    {
+        while (m_locked.exchange(true, std::memory_order_acquire)) {
+            while (m_locked.load(std::memory_order_relaxed))
+                ;
+        }
+    }
+
+    void unlock() const { m_locked.store(false, std::memory_order_release); }
+
+    mutable std::atomic<void*> m_ptr { nullptr };
+    mutable std::atomic<bool> m_locked { false };
+    size_t m_block_size { 0 };
+    size_t m_block_alignment { 0 };
 };
 
 } // namespace Internal
 
+// `T` must inherit `Weakable<T>` after `RefCounted<T>` or `AtomicRefCounted<T>`,
+// so that the reference count is still alive while `~Weakable` invalidates the weak pointers
 template<typename T>
 class Weakable {
     TK_MAKE_NONCOPYABLE(Weakable)
 
+    friend class Internal::WeakFlag;
+
+    template<typename U>
+    friend class RefCounted;
+
+    template<typename U>
+    friend class AtomicRefCounted;
+
 public:
     WeakPtr<T> weak_from_this() const
     {
-        if (!m_flag)
-            m_flag = RefPtr<Internal::WeakFlag> { new Internal::WeakFlag(const_cast<T*>(static_cast<const T*>(this))) };
-
-        return WeakPtr<T> { m_flag };
+        Internal::WeakFlag* flag = m_flag.load(std::memory_order_acquire);
+        if (!flag) {
+            // Several threads may race to create the flag, all but one of them throw theirs away
+            auto* new_flag = new Internal::WeakFlag(const_cast<T*>(static_cast<const T*>(this)));
+            new_flag->ref();
+            if (m_flag.compare_exchange_strong(flag, new_flag, std::memory_order_acq_rel, std::memory_order_acquire))
+                flag = new_flag;
+            else
+                new_flag->deref();
+        }
+
+        return WeakPtr<T> { RefPtr<Internal::WeakFlag> { flag } };
     }
 
 protected:
@@ -59,12 +173,38 @@ protected:
 
     ~Weakable()
     {
-        if (m_flag)
-            m_flag->invalidate();
+        if (Internal::WeakFlag* flag = m_flag.load(std::memory_order_acquire)) {
+            flag->invalidate();
+
+            // A fused flag still holds the storage we are running in, `destroy_if_fused()` lets go of it
+            if (!flag->is_fused())
+                flag->deref();
+        }
     }
 
 private:
-    mutable RefPtr<Internal::WeakFlag> m_flag { nullptr };
+    // Destroys an object made by `make_ref_with_weak()` in place, then drops its reference to the flag owning the block
+    bool destroy_if_fused() const
+    {
+        Internal::WeakFlag* flag = m_flag.load(std::memory_order_acquire);
+        if (!flag || !flag->is_fused())
+            return false;
+
+        static_cast<const T*>(this)->~T();
+        flag->deref();
+        return true;
+    }
+
+    mutable std::atomic<Internal::WeakFlag*> m_flag { nullptr };
 };
 
+// Allocates the object and its weak flag in one block, halving the allocations of weakly referenced objects
+// `weak_from_this()` never allocates for such objects, and the block is freed once the object and all its `WeakPtr`s are gone
+template<typename T, typename... Args> requires(std::is_constructible<T, Args...>::value && std::is_base_of<Weakable<T>, T>::value)
+Ref<T> make_ref_with_weak(Args&&... args)
+{
+    T* ptr = Internal::WeakFlag::make_fused<T>(TK::forward<Args>(args)...);
+    return *ptr;
+}
+
 } // namespace TK
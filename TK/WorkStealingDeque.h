@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Allocator.h"
+#include "Definitions.h"
+#include "NonCopyable.h"
+#include "NonMovable.h"
+#include "Vector.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+namespace TK {
+
+/* Chase-Lev Work Stealing Deque */
+// The owner thread pushes and pops at the bottom like a stack, any other thread may steal from the top
+// Only a steal racing the owner for the very last element needs a CAS, the owner's own operations are a few plain loads and stores
+// The ring grows on demand; the arrays it outgrew are kept until the deque dies, since a thief may still be reading one of them
+template<typename T>
+class WorkStealingDeque {
+    TK_MAKE_NONCOPYABLE(WorkStealingDeque)
+    TK_MAKE_NONMOVABLE(WorkStealingDeque)
+
+    static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque elements are copied around racily and must be trivially copyable");
+
+public:
+    static constexpr size_t initial_capacity = 256;
+
+    WorkStealingDeque()
+    {
+        m_array.store(Array::create(initial_capacity), std::memory_order_relaxed);
+    }
+
+    ~WorkStealingDeque()
+    {
+        Array::destroy(m_array.load(std::memory_order_relaxed));
+        for (Array* array : m_retired_arrays)
+            Array::destroy(array);
+    }
+
+    // Owner only
+    void push(T value)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        Array* array = m_array.load(std::memory_order_relaxed);
+        if (bottom - top >= static_cast<int64_t>(array->m_capacity))
+            array = grow(array, top, bottom);
+
+        array->store(bottom, value);
+        m_bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner only, takes the element pushed last
+    bool pop(T& out)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Array* array = m_array.load(std::memory_order_relaxed);
+
+        // Claim the bottom element before looking at the top, a thief does the opposite
+        m_bottom.store(bottom, std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out = array->load(bottom);
+        if (top == bottom) {
+            // The last element, which a thief may be taking at the same time
+            bool won = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread, takes the element pushed first, fails spuriously when racing another steal or the owner
+    bool steal(T& out)
+    {
+        int64_t top = m_top.load(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+        if (top >= bottom)
+            return false;
+
+        Array* array = m_array.load(std::memory_order_acquire);
+        T value = array->load(top);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+
+        out = value;
+        return true;
+    }
+
+    // Only a snapshot when read by a thread other than the owner
+    [[nodiscard]] bool empty_approx() const
+    {
+        return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr size_t cache_line_size = 64;
+
+    struct Array {
+        size_t m_capacity;
+        std::atomic<T>* m_slots;
+
+        T load(int64_t index) const { return m_slots[static_cast<size_t>(index) & (m_capacity - 1)].load(std::memory_order_relaxed); }
+        void store(int64_t index, T value) { m_slots[static_cast<size_t>(index) & (m_capacity - 1)].store(value, std::memory_order_relaxed); }
+
+        static Array* create(size_t capacity)
+        {
+            auto* slots = static_cast<std::atomic<T>*>(DefaultAllocator().allocate(capacity * sizeof(std::atomic<T>), alignof(std::atomic<T>)));
+            for (size_t i = 0; i < capacity; i++)
+                new (&slots[i]) std::atomic<T>();
+            return new Array { capacity, slots };
+        }
+
+        static void destroy(Array* array)
+        {
+            DefaultAllocator().deallocate(array->m_slots, array->m_capacity * sizeof(std::atomic<T>), alignof(std::atomic<T>));
+            delete array;
+        }
+    };
+
+    NEVER_INLINE Array* grow(Array* array, int64_t top, int64_t bottom)
+    {
+        Array* bigger = Array::create(array->m_capacity * 2);
+        for (int64_t i = top; i < bottom; i++)
+            bigger->store(i, array->load(i));
+
+        m_retired_arrays.push_back(array);
+        m_array.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+private:
+    alignas(cache_line_size) std::atomic<int64_t> m_top { 0 };
+    alignas(cache_line_size) std::atomic<int64_t> m_bottom { 0 };
+    std::atomic<Array*> m_array { nullptr };
+    Vector<Array*> m_retired_arrays { };
+};
+
+}
+
+using TK::WorkStealingDeque;